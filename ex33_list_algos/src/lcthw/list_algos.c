@@ -1,5 +1,6 @@
 #include <lcthw/list_algos.h>
 #include <lcthw/dbg.h>
+#include <pthread.h>
 
 inline void ListNode_swap(ListNode * a, ListNode * b)
 {
@@ -26,66 +27,760 @@ int List_bubble_sort(List *list, List_compare cmp){
     return 0;
 }
 
-inline List *List_merge(List * left, List * right, List_compare cmp)
+// Merges two NULL terminated chains linked through ->next. Ties go
+// to a so the sort stays stable. prev pointers are left stale.
+static inline ListNode *ListNode_merge(ListNode * a, ListNode * b,
+        List_compare cmp)
 {
-    List *result = List_create();
-    void *val = NULL;
+    ListNode head = {.next = NULL };
+    ListNode *tail = &head;
 
-    while (List_count(left) > 0 || List_count(right) > 0) {
-        if (List_count(left) > 0 && List_count(right) > 0) {
-            if (cmp(List_first(left), List_first(right)) <= 0) {
-                val = List_shift(left);
+    while (a && b) {
+        if (cmp(a->value, b->value) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = a ? a : b;
+
+    return head.next;
+}
+
+// Rebuilds prev and last from a chain that only has valid ->next links.
+static inline void List_relink(List * list, ListNode * first)
+{
+    ListNode *prev = NULL;
+    ListNode *cur = first;
+
+    while (cur) {
+        cur->prev = prev;
+        prev = cur;
+        cur = cur->next;
+    }
+
+    list->first = first;
+    list->last = prev;
+}
+
+// Bottom-up merge sort that relinks the nodes of list in place. bins[i]
+// holds a sorted run of 2^i nodes (a binary counter), so there is no
+// recursion and no allocation. Returns list.
+List *List_merge_sort(List * list, List_compare cmp)
+{
+    ListNode *bins[LIST_SORT_BINS] = { NULL };
+    int i = 0;
+
+    if (List_count(list) <= 1) {
+        return list;
+    }
+
+    ListNode *cur = list->first;
+    while (cur) {
+        ListNode *run = cur;
+        cur = cur->next;
+        run->next = NULL;
+
+        // carry: bins hold runs older than cur, so they merge on the left
+        for (i = 0; bins[i] != NULL; i++) {
+            run = ListNode_merge(bins[i], run, cmp);
+            bins[i] = NULL;
+        }
+        bins[i] = run;
+    }
+
+    ListNode *result = NULL;
+    for (i = 0; i < LIST_SORT_BINS; i++) {
+        if (bins[i]) {
+            result = ListNode_merge(bins[i], result, cmp);
+        }
+    }
+
+    List_relink(list, result);
+
+    return list;
+}
+
+// A sorted chain waiting on the run stack of List_tim_sort.
+typedef struct ListRun {
+    ListNode *head;
+    ListNode *tail;
+    int len;
+} ListRun;
+
+// Does node belong before key? Nodes of the left run win ties.
+static inline int ListNode_wins(ListNode * node, void *key, int left,
+        List_compare cmp)
+{
+    int rc = cmp(node->value, key);
+    return left ? rc <= 0 : rc < 0;
+}
+
+// Starting from a node that already wins against key, finds the last
+// node of the chain that still wins. Lists can't be indexed, so this
+// probes 1, 2, 4, ... nodes ahead and then bisects the last gap: the
+// walk is linear but the comparisons are logarithmic.
+static inline ListNode *ListNode_gallop(ListNode * node, void *key,
+        int left, List_compare cmp)
+{
+    int step = 1;
+
+    while (1) {
+        ListNode *probe = node;
+        int i = 0;
+
+        for (i = 0; i < step && probe->next; i++) {
+            probe = probe->next;
+        }
+
+        if (i == 0) {
+            return node;
+        }
+
+        if (ListNode_wins(probe, key, left, cmp)) {
+            node = probe;
+            step *= 2;
+            continue;
+        }
+
+        // node wins at offset 0, probe loses at offset i
+        int lo = 0;
+        int hi = i;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            ListNode *m = node;
+            for (i = lo; i < mid; i++) {
+                m = m->next;
+            }
+
+            if (ListNode_wins(m, key, left, cmp)) {
+                node = m;
+                lo = mid;
             } else {
-                val = List_shift(right);
+                hi = mid;
             }
+        }
+
+        return node;
+    }
+}
+
+// Merges run b into run a, which precedes it. Runs that are already in
+// order are joined in O(1); otherwise a side that keeps winning is
+// spliced over in whole segments found by galloping.
+static inline void ListRun_merge(ListRun * a, ListRun * b, List_compare cmp)
+{
+    a->len += b->len;
+
+    if (cmp(a->tail->value, b->head->value) <= 0) {
+        a->tail->next = b->head;
+        a->tail = b->tail;
+        return;
+    }
 
-            List_push(result, val);
-        } else if (List_count(left) > 0) {
-            val = List_shift(left);
-            List_push(result, val);
-        } else if (List_count(right) > 0) {
-            val = List_shift(right);
-            List_push(result, val);
+    ListNode head = {.next = NULL };
+    ListNode *tail = &head;
+    ListNode *x = a->head;
+    ListNode *y = b->head;
+    int x_wins = 0;
+    int y_wins = 0;
+
+    while (x && y) {
+        if (cmp(x->value, y->value) <= 0) {
+            ListNode *end = x;
+            if (++x_wins >= LIST_MIN_GALLOP) {
+                end = ListNode_gallop(x, y->value, 1, cmp);
+                x_wins = 0;
+            }
+            tail->next = x;
+            tail = end;
+            x = end->next;
+            y_wins = 0;
+        } else {
+            ListNode *end = y;
+            if (++y_wins >= LIST_MIN_GALLOP) {
+                end = ListNode_gallop(y, x->value, 0, cmp);
+                y_wins = 0;
+            }
+            tail->next = y;
+            tail = end;
+            y = end->next;
+            x_wins = 0;
         }
     }
 
-    return result;
+    if (x) {
+        tail->next = x;
+    } else {
+        tail->next = y;
+        a->tail = b->tail;
+    }
+
+    a->head = head.next;
 }
 
-List *List_merge_sort(List * list, List_compare cmp)
+// Takes the next natural run off the chain at *cur, reversing it if it
+// is strictly descending and growing it to LIST_MIN_RUN by insertion.
+static inline ListRun List_next_run(ListNode ** cur, List_compare cmp)
+{
+    ListRun run = {.head = *cur, .tail = *cur, .len = 1 };
+    ListNode *node = (*cur)->next;
+
+    if (node && cmp(run.head->value, node->value) > 0) {
+        // strictly descending, so reversing it keeps the sort stable
+        ListNode *seen = run.head;
+        run.head->next = NULL;
+        while (node && cmp(seen->value, node->value) > 0) {
+            ListNode *next = node->next;
+            node->next = run.head;
+            run.head = node;
+            seen = node;
+            node = next;
+            run.len++;
+        }
+    } else {
+        while (node && cmp(run.tail->value, node->value) <= 0) {
+            run.tail = node;
+            node = node->next;
+            run.len++;
+        }
+        run.tail->next = NULL;
+    }
+
+    while (node && run.len < LIST_MIN_RUN) {
+        ListNode *x = node;
+        node = node->next;
+        run.len++;
+
+        if (cmp(run.tail->value, x->value) <= 0) {
+            run.tail->next = x;
+            run.tail = x;
+            x->next = NULL;
+        } else if (cmp(run.head->value, x->value) > 0) {
+            x->next = run.head;
+            run.head = x;
+        } else {
+            // goes after every node that is <= x
+            ListNode *p = run.head;
+            while (cmp(p->next->value, x->value) <= 0) {
+                p = p->next;
+            }
+            x->next = p->next;
+            p->next = x;
+        }
+    }
+
+    *cur = node;
+    return run;
+}
+
+// Merges runs[i + 1] into runs[i] and closes the gap on the stack.
+static inline void List_merge_at(ListRun * runs, int *n, int i,
+        List_compare cmp)
 {
-    List *result = NULL;
+    ListRun_merge(&runs[i], &runs[i + 1], cmp);
+    if (i + 2 < *n) {
+        runs[i + 1] = runs[i + 2];
+    }
+    (*n)--;
+}
+
+List *List_tim_sort(List * list, List_compare cmp)
+{
+    // the length invariants keep the stack shorter than log_phi(2^63)
+    ListRun runs[LIST_SORT_BINS * 2];
+    int n = 0;
 
     if (List_count(list) <= 1) {
         return list;
     }
 
-    List *left = List_create();
-    List *right = List_create();
-    int middle = List_count(list) / 2;
+    ListNode *cur = list->first;
+    while (cur) {
+        runs[n++] = List_next_run(&cur, cmp);
+
+        // restore the TimSort invariants on the top three run lengths
+        while (n > 1) {
+            int i = n - 2;
+            if ((i > 0 && runs[i - 1].len <= runs[i].len + runs[i + 1].len)
+                    || (i > 1 && runs[i - 2].len
+                        <= runs[i - 1].len + runs[i].len)) {
+                if (runs[i - 1].len < runs[i + 1].len) {
+                    i--;
+                }
+            } else if (runs[i].len > runs[i + 1].len) {
+                break;
+            }
+            List_merge_at(runs, &n, i, cmp);
+        }
+    }
+
+    while (n > 1) {
+        List_merge_at(runs, &n, n - 2, cmp);
+    }
+
+    List_relink(list, runs[0].head);
+
+    return list;
+}
+
+List *List_merge(List * left, List * right, List_compare cmp)
+{
+    ListNode head = {.next = NULL };
+    ListNode *tail = &head;
+    ListNode *a = left->first;
+    ListNode *b = right->first;
+
+    while (a && b) {
+        if (cmp(a->value, b->value) <= 0) {
+            tail->next = a;
+            a->prev = tail;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b->prev = tail;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+
+    // the rest of whichever list remains is already linked
+    if (a) {
+        tail->next = a;
+        a->prev = tail;
+    } else if (b) {
+        tail->next = b;
+        b->prev = tail;
+        left->last = right->last;
+    }
+
+    if (head.next) {
+        head.next->prev = NULL;
+        left->first = head.next;
+    }
+
+    left->count += right->count;
+    right->first = NULL;
+    right->last = NULL;
+    right->count = 0;
+
+    return left;
+}
+
+// Heap order on the lists' current first nodes, ties to the lower index.
+static inline int List_heap_less(List ** lists, int a, int b,
+        List_compare cmp)
+{
+    int rc = cmp(lists[a]->first->value, lists[b]->first->value);
+    return rc < 0 || (rc == 0 && a < b);
+}
+
+static inline void List_heap_sift(List ** lists, int *heap, int n, int i,
+        List_compare cmp)
+{
+    int top = heap[i];
+
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= n) {
+            break;
+        }
+        if (child + 1 < n
+                && List_heap_less(lists, heap[child + 1], heap[child], cmp)) {
+            child++;
+        }
+        if (!List_heap_less(lists, heap[child], top, cmp)) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = top;
+}
+
+List *List_merge_k(List ** lists, int k, List_compare cmp)
+{
+    int stack_heap[LIST_MERGE_K_STACK];
+    int *heap = stack_heap;
+    ListNode head = {.next = NULL };
+    ListNode *tail = &head;
+    int count = 0;
+    int n = 0;
+    int i = 0;
+
+    check(lists && k > 0, "Need at least one list to merge.");
+    check(cmp, "cmp can't be NULL");
+
+    if (k == 2) {
+        return List_merge(lists[0], lists[1], cmp);
+    }
+
+    if (k > LIST_MERGE_K_STACK) {
+        heap = malloc(k * sizeof(int));
+        check_mem(heap);
+    }
+
+    // each list's first pointer doubles as its cursor
+    for (i = 0; i < k; i++) {
+        count += lists[i]->count;
+        if (lists[i]->first) {
+            heap[n++] = i;
+        }
+    }
+
+    for (i = n / 2 - 1; i >= 0; i--) {
+        List_heap_sift(lists, heap, n, i, cmp);
+    }
+
+    while (n > 1) {
+        List *src = lists[heap[0]];
+        ListNode *node = src->first;
+
+        tail->next = node;
+        node->prev = tail;
+        tail = node;
+
+        src->first = node->next;
+        if (src->first == NULL) {
+            heap[0] = heap[--n];
+        }
+        List_heap_sift(lists, heap, n, 0, cmp);
+    }
+
+    // the last list left is already linked, splice it whole
+    ListNode *last = tail;
+    if (n == 1) {
+        List *src = lists[heap[0]];
+        tail->next = src->first;
+        src->first->prev = tail;
+        last = src->last;
+    }
+
+    for (i = 1; i < k; i++) {
+        lists[i]->first = NULL;
+        lists[i]->last = NULL;
+        lists[i]->count = 0;
+    }
+
+    if (head.next) {
+        head.next->prev = NULL;
+        lists[0]->first = head.next;
+        lists[0]->last = last;
+    } else {
+        lists[0]->first = NULL;
+        lists[0]->last = NULL;
+    }
+    lists[0]->count = count;
+
+    if (heap != stack_heap) {
+        free(heap);
+    }
+
+    return lists[0];
+
+error:
+    return NULL;
+}
+
+typedef struct ListSortJob {
+    List *left;
+    List *right;
+    List_compare cmp;
+} ListSortJob;
+
+static void *List_sort_job(void *arg)
+{
+    ListSortJob *job = arg;
+
+    if (job->right) {
+        List_merge(job->left, job->right, job->cmp);
+    } else {
+        List_merge_sort(job->left, job->cmp);
+    }
+
+    return NULL;
+}
+
+// Runs every job on its own thread, or inline if a thread can't start.
+static void List_run_jobs(ListSortJob * jobs, pthread_t * threads, int njobs)
+{
+    int *started = calloc(njobs, sizeof(int));
+    int i = 0;
+
+    for (i = 0; i < njobs; i++) {
+        if (started &&
+                pthread_create(&threads[i], NULL, List_sort_job,
+                    &jobs[i]) == 0) {
+            started[i] = 1;
+        } else {
+            List_sort_job(&jobs[i]);
+        }
+    }
+
+    for (i = 0; i < njobs; i++) {
+        if (started && started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    free(started);
+}
+
+List *List_parallel_merge_sort(List * list, List_compare cmp, int nthreads)
+{
+    List **runs = NULL;
+    ListSortJob *jobs = NULL;
+    pthread_t *threads = NULL;
+    int nruns = 0;
+    int i = 0;
+
+    check(list != NULL, "List is NULL.");
+
+    if (nthreads > List_count(list) / LIST_PARALLEL_MIN) {
+        nthreads = List_count(list) / LIST_PARALLEL_MIN;
+    }
 
+    if (nthreads <= 1) {
+        return List_merge_sort(list, cmp);
+    }
+
+    runs = calloc(nthreads, sizeof(List *));
+    jobs = calloc(nthreads, sizeof(ListSortJob));
+    threads = calloc(nthreads, sizeof(pthread_t));
+    check_mem(runs && jobs && threads);
+
+    // cut the list into equal runs, each split only walks its own run
+    int size = List_count(list) / nthreads;
+    runs[0] = list;
+    for (nruns = 1; nruns < nthreads; nruns++) {
+        runs[nruns] = List_split(runs[nruns - 1], size);
+        check(runs[nruns] != NULL, "Failed to split run %d.", nruns);
+    }
+
+    for (i = 0; i < nruns; i++) {
+        jobs[i].left = runs[i];
+        jobs[i].right = NULL;
+        jobs[i].cmp = cmp;
+    }
+    List_run_jobs(jobs, threads, nruns);
+
+    // tree merge: each round merges neighbouring runs in parallel
+    int stride = 1;
+    for (stride = 1; stride < nruns; stride *= 2) {
+        int njobs = 0;
+        for (i = 0; i + stride < nruns; i += 2 * stride) {
+            jobs[njobs].left = runs[i];
+            jobs[njobs].right = runs[i + stride];
+            jobs[njobs].cmp = cmp;
+            njobs++;
+        }
+        List_run_jobs(jobs, threads, njobs);
+    }
+
+    for (i = 1; i < nruns; i++) {
+        List_destroy(runs[i]);
+    }
+
+    free(runs);
+    free(jobs);
+    free(threads);
+
+    return list;
+
+error:
+    // put back whatever runs were split off
+    for (i = 1; i < nruns; i++) {
+        List_join(list, runs[i]);
+        free(runs[i]);
+    }
+    free(runs);
+    free(jobs);
+    free(threads);
+    return NULL;
+}
+
+List *List_radix_sort(List * list, List_key_int key)
+{
+    ListNode *heads[LIST_RADIX_BUCKETS];
+    ListNode **tails[LIST_RADIX_BUCKETS];
+    int shift = 0;
+    int b = 0;
+
+    check(list, "List is NULL");
+    check(key, "key can't be NULL");
+
+    if (list->count < 2) {
+        return list;
+    }
+
+    // bits that differ anywhere; passes over constant bytes are no-ops
+    uint64_t first_key = key(list->first->value);
+    uint64_t diff = 0;
     LIST_FOREACH(list, first, next, cur) {
-        if (middle > 0) {
-            List_push(left, cur->value);
+        diff |= key(cur->value) ^ first_key;
+    }
+
+    ListNode *chain = list->first;
+
+    for (shift = 0; shift < 64; shift += LIST_RADIX_BITS) {
+        if (((diff >> shift) & (LIST_RADIX_BUCKETS - 1)) == 0) {
+            continue;
+        }
+
+        for (b = 0; b < LIST_RADIX_BUCKETS; b++) {
+            tails[b] = &heads[b];
+        }
+
+        // only links behind cur are rewritten, so cur->next is intact
+        for (cur = chain; cur != NULL; cur = cur->next) {
+            b = (key(cur->value) >> shift) & (LIST_RADIX_BUCKETS - 1);
+            *tails[b] = cur;
+            tails[b] = &cur->next;
+        }
+
+        ListNode **link = &chain;
+        for (b = 0; b < LIST_RADIX_BUCKETS; b++) {
+            if (tails[b] != &heads[b]) {
+                *link = heads[b];
+                link = tails[b];
+            }
+        }
+        *link = NULL;
+    }
+
+    List_relink(list, chain);
+
+    return list;
+
+error:
+    return NULL;
+}
+
+// Stable top-down merge sort of a count node chain on key + depth.
+static ListNode *ListNode_str_merge_sort(ListNode * chain, int count,
+        List_key_str key, size_t depth)
+{
+    if (count <= 1) {
+        if (chain) {
+            chain->next = NULL;
+        }
+        return chain;
+    }
+
+    int half = count / 2;
+    ListNode *mid = chain;
+    int i = 0;
+    for (i = 1; i < half; i++) {
+        mid = mid->next;
+    }
+    ListNode *right = mid->next;
+    mid->next = NULL;
+
+    ListNode *a = ListNode_str_merge_sort(chain, half, key, depth);
+    ListNode *b = ListNode_str_merge_sort(right, count - half, key, depth);
+    ListNode head = {.next = NULL };
+    ListNode *tail = &head;
+
+    while (a && b) {
+        if (strcmp(key(a->value) + depth, key(b->value) + depth) <= 0) {
+            tail->next = a;
+            a = a->next;
         } else {
-            List_push(right, cur->value);
+            tail->next = b;
+            b = b->next;
         }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+
+    return head.next;
+}
+
+// Sorts a NULL terminated chain of count nodes whose keys all share
+// their first depth bytes. Returns the new first node, *last the last.
+static ListNode *ListNode_radix_str(ListNode * chain, int count,
+        List_key_str key, size_t depth, ListNode ** last)
+{
+    ListNode *heads[LIST_RADIX_STR_BUCKETS];
+    ListNode *tails[LIST_RADIX_STR_BUCKETS];
+    int counts[LIST_RADIX_STR_BUCKETS];
+    ListNode *result = NULL;
+    ListNode *cur = NULL;
+    int b = 0;
 
-        middle--;
+    if (count < LIST_RADIX_MIN_BUCKET || depth >= LIST_RADIX_MAX_DEPTH) {
+        result = ListNode_str_merge_sort(chain, count, key, depth);
+        for (cur = result; cur->next != NULL; cur = cur->next) {
+        }
+        *last = cur;
+        return result;
     }
 
-    List *sort_left = List_merge_sort(left, cmp);
-    List *sort_right = List_merge_sort(right, cmp);
+    for (b = 0; b < LIST_RADIX_STR_BUCKETS; b++) {
+        heads[b] = NULL;
+        counts[b] = 0;
+    }
 
-    if (sort_left != left)
-        List_destroy(left);
-    if (sort_right != right)
-        List_destroy(right);
+    for (cur = chain; cur != NULL; cur = cur->next) {
+        b = (unsigned char)key(cur->value)[depth];
+        if (heads[b] == NULL) {
+            heads[b] = cur;
+        } else {
+            tails[b]->next = cur;
+        }
+        tails[b] = cur;
+        counts[b]++;
+    }
 
-    result = List_merge(sort_left, sort_right, cmp);
+    *last = NULL;
+    for (b = 0; b < LIST_RADIX_STR_BUCKETS; b++) {
+        if (heads[b] == NULL) {
+            continue;
+        }
+
+        ListNode *sub = heads[b];
+        ListNode *sub_last = tails[b];
+        sub_last->next = NULL;
 
-    List_destroy(sort_left);
-    List_destroy(sort_right);
+        // bucket 0 holds keys that end here: all equal, already stable
+        if (b > 0) {
+            sub = ListNode_radix_str(sub, counts[b], key, depth + 1,
+                    &sub_last);
+        }
+
+        if (result == NULL) {
+            result = sub;
+        } else {
+            (*last)->next = sub;
+        }
+        *last = sub_last;
+    }
 
     return result;
 }
+
+List *List_radix_sort_str(List * list, List_key_str key)
+{
+    ListNode *last = NULL;
+
+    check(list, "List is NULL");
+    check(key, "key can't be NULL");
+
+    if (list->count < 2) {
+        return list;
+    }
+
+    ListNode *first = ListNode_radix_str(list->first, list->count, key,
+            0, &last);
+    List_relink(list, first);
+
+    return list;
+
+error:
+    return NULL;
+}
@@ -2,11 +2,77 @@
 #define lcthw_List_algos_h
 
 #include <lcthw/list.h>
+#include <stdint.h>
 
 typedef int (*List_compare) (const void *a, const void *b);
 
 int List_bubble_sort(List * list, List_compare cmp);
 
+// Enough bins for 2^63 nodes.
+#define LIST_SORT_BINS 64
+
+// Stable, allocation free; sorts list in place and returns it.
 List *List_merge_sort(List * list, List_compare cmp);
 
+// Natural runs shorter than this are extended by insertion.
+#define LIST_MIN_RUN 32
+// Wins in a row before a merge switches to galloping.
+#define LIST_MIN_GALLOP 7
+
+// Adaptive, stable, allocation free sort in the style of TimSort. It
+// finds ascending and strictly descending runs (reversing the latter),
+// and merges them with galloping, so nearly sorted input costs close
+// to O(n). Sorts list in place and returns it.
+List *List_tim_sort(List * list, List_compare cmp);
+
+// Stable merge of two sorted lists by relinking. All of right's nodes
+// move into left, right is left empty. Returns left.
+List *List_merge(List * left, List * right, List_compare cmp);
+
+// Up to this many lists are merged without a heap allocation.
+#define LIST_MERGE_K_STACK 64
+
+// Merges k sorted lists into lists[0] through a binary heap of list
+// heads, in O(n log k) compares. Nodes are relinked, never allocated;
+// the other lists are left empty. Stable: ties go to the lower list
+// index. Returns lists[0], or NULL on bad arguments.
+List *List_merge_k(List ** lists, int k, List_compare cmp);
+
+// Lists shorter than this are sorted on the calling thread.
+#define LIST_PARALLEL_MIN 8192
+
+// Splits list into nthreads runs, sorts them concurrently and merges
+// them back pairwise, also in parallel. Stable; returns list, or NULL
+// if the runs could not be set up.
+List *List_parallel_merge_sort(List * list, List_compare cmp, int nthreads);
+
+// Key extraction for the radix sorts.
+typedef uint64_t (*List_key_int) (const void *value);
+typedef const char *(*List_key_str) (const void *value);
+
+// Maps a signed key to an unsigned one with the same order.
+#define List_radix_signed(X) ((uint64_t)(int64_t)(X) ^ (1ULL << 63))
+
+// Bits per integer radix pass: each pass chases every node once, so
+// fewer, wider passes win (32 bit keys take 3).
+#define LIST_RADIX_BITS 11
+#define LIST_RADIX_BUCKETS (1 << LIST_RADIX_BITS)
+
+// Stable LSD radix sort on unsigned 64 bit keys. Nodes are relinked
+// into buckets, LIST_RADIX_BITS of the key per pass; digits that are
+// the same in every key are skipped, so small keys take fewer passes.
+// Returns list.
+List *List_radix_sort(List * list, List_key_int key);
+
+// Buckets smaller than this, or deeper than this many bytes into the
+// key, are finished with a merge sort on the rest of the key.
+#define LIST_RADIX_MIN_BUCKET 32
+#define LIST_RADIX_MAX_DEPTH 64
+// String passes go one byte at a time.
+#define LIST_RADIX_STR_BUCKETS 256
+
+// Stable MSD radix sort on NUL terminated keys, in strcmp order.
+// Returns list.
+List *List_radix_sort_str(List * list, List_key_str key);
+
 #endif
\ No newline at end of file
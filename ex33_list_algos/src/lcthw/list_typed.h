@@ -0,0 +1,236 @@
+#ifndef lcthw_List_typed_h
+#define lcthw_List_typed_h
+
+#include <stdlib.h>
+#include <lcthw/dbg.h>
+#include <lcthw/list_algos.h>
+
+// Type specialized lists. DEFINE_LIST(N, T, CMP) generates a list type
+// N of N##_node that holds T values inline, and static inline functions
+// N##_create, _destroy, _push, _pop, _unshift, _shift, _merge,
+// _merge_sort and _find. CMP is an expression over two T values named
+// a and b that is < 0, 0 or > 0 like a List_compare, e.g.
+//
+//     DEFINE_LIST(int_list, int64_t, (a > b) - (a < b))
+//
+// CMP is pasted into the sort and search loops, so the compiler sees
+// it instead of a call through a function pointer, and reading a value
+// doesn't chase a void *. The algorithms are the same as List_merge
+// and List_merge_sort.
+#define DEFINE_LIST(N, T, CMP) \
+typedef struct N##_node {\
+    struct N##_node *next;\
+    struct N##_node *prev;\
+    T value;\
+} N##_node;\
+\
+typedef struct N {\
+    int count;\
+    N##_node *first;\
+    N##_node *last;\
+} N;\
+\
+static inline int N##_cmp(T a, T b)\
+{\
+    return (CMP);\
+}\
+\
+static inline N *N##_create()\
+{\
+    return calloc(1, sizeof(N));\
+}\
+\
+static inline void N##_destroy(N * list)\
+{\
+    N##_node *cur = list->first;\
+    while (cur) {\
+        N##_node *next = cur->next;\
+        free(cur);\
+        cur = next;\
+    }\
+    free(list);\
+}\
+\
+static inline void N##_push(N * list, T value)\
+{\
+    N##_node *node = malloc(sizeof(N##_node));\
+    check_mem(node);\
+\
+    node->value = value;\
+    node->next = NULL;\
+    node->prev = list->last;\
+    if (list->last) {\
+        list->last->next = node;\
+    } else {\
+        list->first = node;\
+    }\
+    list->last = node;\
+    list->count++;\
+\
+error:\
+    return;\
+}\
+\
+static inline void N##_unshift(N * list, T value)\
+{\
+    N##_node *node = malloc(sizeof(N##_node));\
+    check_mem(node);\
+\
+    node->value = value;\
+    node->prev = NULL;\
+    node->next = list->first;\
+    if (list->first) {\
+        list->first->prev = node;\
+    } else {\
+        list->last = node;\
+    }\
+    list->first = node;\
+    list->count++;\
+\
+error:\
+    return;\
+}\
+\
+/* Copies the removed value into out; returns 0, or -1 if empty. */\
+static inline int N##_pop(N * list, T * out)\
+{\
+    N##_node *node = list->last;\
+    if (node == NULL) {\
+        return -1;\
+    }\
+\
+    list->last = node->prev;\
+    if (list->last) {\
+        list->last->next = NULL;\
+    } else {\
+        list->first = NULL;\
+    }\
+    list->count--;\
+\
+    *out = node->value;\
+    free(node);\
+    return 0;\
+}\
+\
+static inline int N##_shift(N * list, T * out)\
+{\
+    N##_node *node = list->first;\
+    if (node == NULL) {\
+        return -1;\
+    }\
+\
+    list->first = node->next;\
+    if (list->first) {\
+        list->first->prev = NULL;\
+    } else {\
+        list->last = NULL;\
+    }\
+    list->count--;\
+\
+    *out = node->value;\
+    free(node);\
+    return 0;\
+}\
+\
+/* Merges two NULL terminated ->next chains, ties to a. */\
+static inline N##_node *N##_chain_merge(N##_node * a, N##_node * b)\
+{\
+    N##_node head = {.next = NULL };\
+    N##_node *tail = &head;\
+\
+    while (a && b) {\
+        if (N##_cmp(a->value, b->value) <= 0) {\
+            tail->next = a;\
+            a = a->next;\
+        } else {\
+            tail->next = b;\
+            b = b->next;\
+        }\
+        tail = tail->next;\
+    }\
+\
+    tail->next = a ? a : b;\
+    return head.next;\
+}\
+\
+/* Rebuilds prev and last from valid ->next links. */\
+static inline void N##_relink(N * list, N##_node * first)\
+{\
+    N##_node *prev = NULL;\
+    N##_node *cur = first;\
+\
+    while (cur) {\
+        cur->prev = prev;\
+        prev = cur;\
+        cur = cur->next;\
+    }\
+\
+    list->first = first;\
+    list->last = prev;\
+}\
+\
+/* Stable merge by relinking; right is left empty. Returns left. */\
+static inline N *N##_merge(N * left, N * right)\
+{\
+    N##_relink(left, N##_chain_merge(left->first, right->first));\
+    left->count += right->count;\
+\
+    right->first = NULL;\
+    right->last = NULL;\
+    right->count = 0;\
+\
+    return left;\
+}\
+\
+/* Stable bottom-up merge sort, see List_merge_sort. Returns list. */\
+static inline N *N##_merge_sort(N * list)\
+{\
+    N##_node *bins[LIST_SORT_BINS] = { NULL };\
+    int i = 0;\
+\
+    if (list->count <= 1) {\
+        return list;\
+    }\
+\
+    N##_node *cur = list->first;\
+    while (cur) {\
+        N##_node *run = cur;\
+        cur = cur->next;\
+        run->next = NULL;\
+\
+        for (i = 0; bins[i] != NULL; i++) {\
+            run = N##_chain_merge(bins[i], run);\
+            bins[i] = NULL;\
+        }\
+        bins[i] = run;\
+    }\
+\
+    N##_node *result = NULL;\
+    for (i = 0; i < LIST_SORT_BINS; i++) {\
+        if (bins[i]) {\
+            result = N##_chain_merge(bins[i], result);\
+        }\
+    }\
+\
+    N##_relink(list, result);\
+    return list;\
+}\
+\
+/* First node that compares equal to value, or NULL. */\
+static inline N##_node *N##_find(N * list, T value)\
+{\
+    N##_node *cur = NULL;\
+\
+    for (cur = list->first; cur != NULL; cur = cur->next) {\
+        if (N##_cmp(cur->value, value) == 0) {\
+            return cur;\
+        }\
+    }\
+\
+    return NULL;\
+}
+
+#define TLIST_FOREACH(N, L, S, M, V) N##_node *V = NULL;\
+for(V = (L)->S; V != NULL; V = V->M)
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef _bench_h
+#define _bench_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static inline double bench_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Runs the statement block once and stores the elapsed seconds in SECS.
+#define BENCH(SECS, BLOCK) do {\
+    double _start = bench_now();\
+    BLOCK;\
+    (SECS) = bench_now() - _start;\
+} while (0)
+
+static inline void bench_report(const char *name, int n, double secs)
+{
+    printf("%-28s n=%-9d %9.3f ms %8.2f ns/op\n", name, n,
+            secs * 1e3, secs * 1e9 / n);
+}
+
+// Benchmarks take an optional max element count as their first argument.
+#define bench_max_n(ARGC, ARGV, DEFAULT) \
+    ((ARGC) > 1 ? atoi((ARGV)[1]) : (DEFAULT))
+
+#endif
@@ -0,0 +1,283 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <unistd.h>
+#include <string.h>
+
+static int int_compare(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static const char *shapes[] = { "sorted", "reversed", "random", "99% sorted" };
+
+// Builds the list over one contiguous node array in push order, so
+// every run starts from the same memory layout no matter how earlier
+// sorts scattered freed nodes around the heap. Free with bench_free.
+static List *shaped_list(int *keys, int n, int shape)
+{
+    List *list = List_create();
+    ListNode *nodes = calloc(n, sizeof(ListNode));
+    int i = 0;
+
+    srand(1);
+    for (i = 0; i < n; i++) {
+        switch (shape) {
+            case 0: keys[i] = i; break;
+            case 1: keys[i] = n - i; break;
+            case 2: keys[i] = rand(); break;
+            default: keys[i] = rand() % 100 == 0 ? rand() % n : i;
+        }
+        nodes[i].value = &keys[i];
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = i < n - 1 ? &nodes[i + 1] : NULL;
+    }
+
+    list->first = &nodes[0];
+    list->last = &nodes[n - 1];
+    list->count = n;
+
+    return list;
+}
+
+static void bench_free(List * list)
+{
+    // after sorting the array base is simply the lowest node address
+    ListNode *nodes = NULL;
+    LIST_FOREACH(list, first, next, cur) {
+        if (nodes == NULL || cur < nodes) {
+            nodes = cur;
+        }
+    }
+    free(nodes);
+    free(list);
+}
+
+static void bench_adaptive(int n)
+{
+    int *keys = malloc(n * sizeof(int));
+    int shape = 0;
+    double secs = 0;
+    char name[64];
+
+    for (shape = 0; shape < 4; shape++) {
+        List *list = shaped_list(keys, n, shape);
+        BENCH(secs, List_merge_sort(list, int_compare));
+        snprintf(name, sizeof(name), "merge sort %s", shapes[shape]);
+        bench_report(name, n, secs);
+        bench_free(list);
+
+        list = shaped_list(keys, n, shape);
+        BENCH(secs, List_tim_sort(list, int_compare));
+        snprintf(name, sizeof(name), "tim sort %s", shapes[shape]);
+        bench_report(name, n, secs);
+        bench_free(list);
+    }
+
+    free(keys);
+}
+
+// Second argument overrides the thread count to scale up to.
+static void bench_parallel_run(int *keys, int n, int nthreads)
+{
+    List *list = shaped_list(keys, n, 2);
+    double secs = 0;
+    char name[64];
+
+    BENCH(secs, List_parallel_merge_sort(list, int_compare, nthreads));
+    snprintf(name, sizeof(name), "parallel sort %d threads", nthreads);
+    bench_report(name, n, secs);
+
+    bench_free(list);
+}
+
+static void bench_parallel(int argc, char *argv[], int n)
+{
+    int max_threads = argc > 2 ? atoi(argv[2])
+        : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int *keys = malloc(n * sizeof(int));
+    int nthreads = 0;
+
+    if (max_threads < 1) {
+        max_threads = 1;
+    }
+
+    // powers of two below max_threads, then max_threads itself
+    for (nthreads = 1; nthreads < max_threads; nthreads *= 2) {
+        bench_parallel_run(keys, n, nthreads);
+    }
+    bench_parallel_run(keys, n, max_threads);
+
+    free(keys);
+}
+
+#define MAX_MERGE_K 256
+
+// Deals a sorted list out round robin into k sorted lists.
+static void deal_lists(List ** lists, int *keys, int n, int k)
+{
+    List *all = shaped_list(keys, n, 0);
+    ListNode *cur = all->first;
+    int i = 0;
+
+    for (i = 0; i < k; i++) {
+        lists[i] = List_create();
+    }
+
+    for (i = 0; cur != NULL; i++) {
+        ListNode *next = cur->next;
+        List *list = lists[i % k];
+
+        cur->next = NULL;
+        cur->prev = list->last;
+        if (list->last) {
+            list->last->next = cur;
+        } else {
+            list->first = cur;
+        }
+        list->last = cur;
+        list->count++;
+
+        cur = next;
+    }
+
+    free(all);
+}
+
+static void free_lists(List ** lists, int k)
+{
+    int i = 0;
+
+    // everything ends up in lists[0]
+    bench_free(lists[0]);
+    for (i = 1; i < k; i++) {
+        free(lists[i]);
+    }
+}
+
+static void bench_merge_k(int n)
+{
+    List *lists[MAX_MERGE_K];
+    int *keys = malloc(n * sizeof(int));
+    double secs = 0;
+    char name[64];
+    int k = 0;
+    int i = 0;
+
+    for (k = 2; k <= MAX_MERGE_K; k *= 4) {
+        deal_lists(lists, keys, n, k);
+        BENCH(secs, {
+            for (i = 1; i < k; i++) {
+                List_merge(lists[0], lists[i], int_compare);
+            }
+        });
+        snprintf(name, sizeof(name), "pairwise merge k=%d", k);
+        bench_report(name, n, secs);
+        free_lists(lists, k);
+
+        deal_lists(lists, keys, n, k);
+        BENCH(secs, List_merge_k(lists, k, int_compare));
+        snprintf(name, sizeof(name), "merge_k k=%d", k);
+        bench_report(name, n, secs);
+        free_lists(lists, k);
+    }
+
+    free(keys);
+}
+
+static uint64_t int_key(const void *value)
+{
+    return List_radix_signed(*(const int *)value);
+}
+
+#define WORD_LEN 10
+
+static const char *word_key(const void *value)
+{
+    return value;
+}
+
+static int word_compare(const void *a, const void *b)
+{
+    return strcmp(a, b);
+}
+
+// Random lowercase words packed in one buffer, one node each.
+static List *word_list(char *words, int n)
+{
+    List *list = List_create();
+    ListNode *nodes = calloc(n, sizeof(ListNode));
+    int i = 0;
+    int j = 0;
+
+    srand(1);
+    for (i = 0; i < n; i++) {
+        char *word = &words[i * (WORD_LEN + 1)];
+        for (j = 0; j < WORD_LEN; j++) {
+            word[j] = 'a' + rand() % 26;
+        }
+        word[WORD_LEN] = '\0';
+
+        nodes[i].value = word;
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = i < n - 1 ? &nodes[i + 1] : NULL;
+    }
+
+    list->first = &nodes[0];
+    list->last = &nodes[n - 1];
+    list->count = n;
+
+    return list;
+}
+
+// Runs at 1M, 10M and 50M nodes, as far as the max n allows.
+static void bench_radix(int max_n)
+{
+    int sizes[] = { 1000000, 10000000, 50000000 };
+    double secs = 0;
+    int i = 0;
+
+    for (i = 0; i < 3 && sizes[i] <= max_n; i++) {
+        int n = sizes[i];
+        int *keys = malloc(n * sizeof(int));
+        char *words = malloc((size_t)n * (WORD_LEN + 1));
+
+        List *list = shaped_list(keys, n, 2);
+        BENCH(secs, List_merge_sort(list, int_compare));
+        bench_report("merge sort ints", n, secs);
+        bench_free(list);
+
+        list = shaped_list(keys, n, 2);
+        BENCH(secs, List_radix_sort(list, int_key));
+        bench_report("radix sort ints", n, secs);
+        bench_free(list);
+
+        list = word_list(words, n);
+        BENCH(secs, List_merge_sort(list, word_compare));
+        bench_report("merge sort strings", n, secs);
+        bench_free(list);
+
+        list = word_list(words, n);
+        BENCH(secs, List_radix_sort_str(list, word_key));
+        bench_report("radix sort strings", n, secs);
+        bench_free(list);
+
+        free(keys);
+        free(words);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int n = bench_max_n(argc, argv, 4000000);
+
+    printf("----\nBENCH: list sorts\n");
+
+    bench_parallel(argc, argv, n);
+    bench_adaptive(n);
+    bench_merge_k(n);
+    bench_radix(n);
+
+    return 0;
+}
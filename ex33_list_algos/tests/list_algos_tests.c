@@ -68,24 +68,350 @@ char *test_merge_sort()
 
     // should work on a list that needs sorting
     List *res = List_merge_sort(words, (List_compare) strcmp);
+    mu_assert(res == words, "Merge sort should sort in place.");
     mu_assert(is_sorted(res), "Words are not sorted after merge sort.");
+    mu_assert(List_count(res) == NUM_VALUES, "Merge sort lost nodes.");
 
     List *res2 = List_merge_sort(res, (List_compare) strcmp);
-    mu_assert(is_sorted(res),
+    mu_assert(is_sorted(res2),
             "Should still be sorted after merge sort.");
-    List_destroy(res2);
-    List_destroy(res);
+    mu_assert(res2->last->value == values[3],
+            "Wrong last after merge sort.");
+    mu_assert(res2->last->next == NULL && res2->first->prev == NULL,
+            "Ends are not terminated after merge sort.");
 
     List_destroy(words);
     return NULL;
 }
 
+typedef struct Record {
+    int key;
+    int seq;
+} Record;
+
+static int Record_compare(const void *a, const void *b)
+{
+    return ((Record *)a)->key - ((Record *)b)->key;
+}
+
+#define NUM_RECORDS 100000
+
+static List *create_records(Record * records, int n)
+{
+    List *list = List_create();
+    int i = 0;
+
+    srand(42);
+    for (i = 0; i < n; i++) {
+        records[i].key = rand() % 100;
+        records[i].seq = i;
+        List_push(list, &records[i]);
+    }
+
+    return list;
+}
+
+static char *check_records(List * list, int n)
+{
+    int count = 0;
+    LIST_FOREACH(list, first, next, cur) {
+        Record *rec = cur->value;
+        count++;
+        if (cur->next) {
+            Record *next = cur->next->value;
+            mu_assert(rec->key <= next->key, "Records are not sorted.");
+            mu_assert(rec->key != next->key || rec->seq < next->seq,
+                    "Sort is not stable.");
+            mu_assert(cur->next->prev == cur, "Broken prev link.");
+        } else {
+            mu_assert(list->last == cur, "Wrong last node.");
+        }
+    }
+    mu_assert(count == n, "Forward walk missed nodes.");
+    mu_assert(List_count(list) == n, "Sort lost nodes.");
+    mu_assert(list->first->prev == NULL, "First node has a prev.");
+
+    return NULL;
+}
+
+char *test_merge_sort_stable()
+{
+    Record *records = calloc(NUM_RECORDS, sizeof(Record));
+    List *list = create_records(records, NUM_RECORDS);
+
+    List_merge_sort(list, Record_compare);
+    char *msg = check_records(list, NUM_RECORDS);
+    if (msg) return msg;
+
+    List_destroy(list);
+    free(records);
+
+    return NULL;
+}
+
+// shapes the records as sorted, reversed, random or 99% sorted input
+static List *create_shaped(Record * records, int n, int shape)
+{
+    List *list = List_create();
+    int i = 0;
+
+    srand(7);
+    for (i = 0; i < n; i++) {
+        switch (shape) {
+            case 0: records[i].key = i / 3; break;
+            case 1: records[i].key = (n - i) / 3; break;
+            case 2: records[i].key = rand() % 1000; break;
+            default:
+                records[i].key = rand() % 100 == 0 ? rand() % n : i;
+        }
+        records[i].seq = i;
+        List_push(list, &records[i]);
+    }
+
+    return list;
+}
+
+char *test_tim_sort()
+{
+    Record *records = calloc(NUM_RECORDS, sizeof(Record));
+    int shape = 0;
+
+    List *words = create_words();
+    List_tim_sort(words, (List_compare) strcmp);
+    mu_assert(is_sorted(words), "Words are not sorted after tim sort.");
+    List_destroy(words);
+
+    for (shape = 0; shape < 4; shape++) {
+        List *list = create_shaped(records, NUM_RECORDS, shape);
+
+        List *res = List_tim_sort(list, Record_compare);
+        mu_assert(res == list, "Tim sort should sort in place.");
+        char *msg = check_records(list, NUM_RECORDS);
+        if (msg) return msg;
+
+        List_destroy(list);
+    }
+
+    free(records);
+
+    return NULL;
+}
+
+char *test_merge()
+{
+    List *left = List_create();
+    List *right = List_create();
+    int i = 0;
+
+    List_push(left, values[1]);
+    List_push(left, values[4]);
+    List_push(right, values[0]);
+    List_push(right, values[2]);
+    List_push(right, values[3]);
+
+    List *res = List_merge(left, right, (List_compare) strcmp);
+    mu_assert(res == left, "Merge should return the left list.");
+    mu_assert(List_count(left) == 5, "Wrong count after merge.");
+    mu_assert(List_count(right) == 0, "Right should be empty after merge.");
+    mu_assert(is_sorted(left), "Not sorted after merge.");
+    mu_assert(left->last->value == values[3], "Wrong last after merge.");
+
+    // merging an empty list either way is a no-op
+    List_merge(right, left, (List_compare) strcmp);
+    mu_assert(List_count(right) == 5, "Merge into empty list failed.");
+    List_merge(right, left, (List_compare) strcmp);
+    mu_assert(List_count(right) == 5, "Merge of empty list failed.");
+
+    for (i = 0; i < 5; i++) {
+        List_pop(right);
+    }
+
+    List_destroy(left);
+    List_destroy(right);
+
+    return NULL;
+}
+
+#define MERGE_K 40
+
+char *test_merge_k()
+{
+    Record *records = calloc(NUM_RECORDS, sizeof(Record));
+    List *lists[MERGE_K];
+    int i = 0;
+
+    // deal sorted keys out round robin, seq records the list and order
+    for (i = 0; i < MERGE_K; i++) {
+        lists[i] = List_create();
+    }
+    for (i = 0; i < NUM_RECORDS; i++) {
+        int which = rand() % MERGE_K;
+        // leave one list empty
+        which = which == 3 ? 4 : which;
+        records[i].key = i / 7;
+        records[i].seq = which * NUM_RECORDS + List_count(lists[which]);
+        List_push(lists[which], &records[i]);
+    }
+    int expected = 0;
+    for (i = 0; i < MERGE_K; i++) {
+        expected += List_count(lists[i]);
+    }
+
+    List *res = List_merge_k(lists, MERGE_K, Record_compare);
+    mu_assert(res == lists[0], "Merge k should return the first list.");
+    mu_assert(List_count(res) == expected, "Wrong count after merge k.");
+    for (i = 1; i < MERGE_K; i++) {
+        mu_assert(List_count(lists[i]) == 0 && lists[i]->first == NULL,
+                "Merged lists should be empty.");
+    }
+
+    // equal keys keep list order, then their order within the list
+    int count = 0;
+    LIST_FOREACH(res, first, next, cur) {
+        Record *rec = cur->value;
+        count++;
+        if (cur->next) {
+            Record *next = cur->next->value;
+            mu_assert(rec->key < next->key ||
+                    (rec->key == next->key && rec->seq < next->seq),
+                    "Merge k is not sorted and stable.");
+            mu_assert(cur->next->prev == cur, "Broken prev link.");
+        }
+    }
+    mu_assert(count == expected, "Wrong number of nodes linked.");
+    mu_assert(res->first->prev == NULL && res->last->next == NULL,
+            "Ends are not terminated after merge k.");
+
+    // one list, and all empty lists
+    mu_assert(List_merge_k(lists, 1, Record_compare) == lists[0],
+            "Merge of one list failed.");
+    mu_assert(List_merge_k(&lists[1], MERGE_K - 1, Record_compare)
+            == lists[1] && List_count(lists[1]) == 0,
+            "Merge of empty lists failed.");
+
+    for (i = 0; i < MERGE_K; i++) {
+        List_destroy(lists[i]);
+    }
+    free(records);
+
+    return NULL;
+}
+
+static uint64_t Record_key(const void *value)
+{
+    return List_radix_signed(((Record *)value)->key);
+}
+
+char *test_radix_sort()
+{
+    Record *records = calloc(NUM_RECORDS, sizeof(Record));
+    List *list = create_records(records, NUM_RECORDS);
+
+    List *res = List_radix_sort(list, Record_key);
+    mu_assert(res == list, "Radix sort should sort in place.");
+    char *msg = check_records(list, NUM_RECORDS);
+    if (msg) return msg;
+    List_destroy(list);
+
+    // negative and wide keys need every pass and the sign flip
+    list = create_records(records, NUM_RECORDS);
+    LIST_FOREACH(list, first, next, cur) {
+        Record *rec = cur->value;
+        rec->key = rand() - RAND_MAX / 2;
+    }
+    List_radix_sort(list, Record_key);
+    msg = check_records(list, NUM_RECORDS);
+    if (msg) return msg;
+    List_destroy(list);
+
+    free(records);
+
+    return NULL;
+}
+
+#define NUM_WORDS 20000
+
+static const char *Word_key(const void *value)
+{
+    return value;
+}
+
+char *test_radix_sort_str()
+{
+    char (*words)[12] = calloc(NUM_WORDS, sizeof(*words));
+    List *list = List_create();
+    List *expected = List_create();
+    int i = 0;
+
+    // short alphabets give long shared prefixes, empty keys and keys
+    // that are prefixes of others
+    srand(7);
+    for (i = 0; i < NUM_WORDS; i++) {
+        int len = rand() % 11;
+        int j = 0;
+        for (j = 0; j < len; j++) {
+            words[i][j] = "ab\xe9"[rand() % 3];
+        }
+        List_push(list, words[i]);
+        List_push(expected, words[i]);
+    }
+
+    List *res = List_radix_sort_str(list, Word_key);
+    mu_assert(res == list, "Radix sort should sort in place.");
+    List_merge_sort(expected, (List_compare) strcmp);
+
+    // same pointers in the same order means stable as well as sorted
+    ListNode *want = expected->first;
+    LIST_FOREACH(list, first, next, cur) {
+        mu_assert(cur->value == want->value,
+                "String radix sort differs from merge sort.");
+        mu_assert(cur->next == NULL || cur->next->prev == cur,
+                "Broken prev link.");
+        want = want->next;
+    }
+    mu_assert(list->last->value == expected->last->value, "Wrong last.");
+
+    List_destroy(list);
+    List_destroy(expected);
+    free(words);
+
+    return NULL;
+}
+
+char *test_parallel_merge_sort()
+{
+    Record *records = calloc(NUM_RECORDS, sizeof(Record));
+    int nthreads = 0;
+
+    for (nthreads = 1; nthreads <= 8; nthreads++) {
+        List *list = create_records(records, NUM_RECORDS);
+
+        List *res = List_parallel_merge_sort(list, Record_compare, nthreads);
+        mu_assert(res == list, "Parallel sort should sort in place.");
+        char *msg = check_records(list, NUM_RECORDS);
+        if (msg) return msg;
+
+        List_destroy(list);
+    }
+
+    free(records);
+
+    return NULL;
+}
+
 char *all_tests()
 {
     mu_suite_start();
 
     mu_run_test(test_bubble_sort);
     mu_run_test(test_merge_sort);
+    mu_run_test(test_merge_sort_stable);
+    mu_run_test(test_tim_sort);
+    mu_run_test(test_merge);
+    mu_run_test(test_merge_k);
+    mu_run_test(test_radix_sort);
+    mu_run_test(test_radix_sort_str);
+    mu_run_test(test_parallel_merge_sort);
 
     return NULL;
 }
@@ -0,0 +1,51 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/list_typed.h>
+#include <stdint.h>
+
+DEFINE_LIST(int_list, int64_t, (a > b) - (a < b))
+
+static int int64_compare(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 1000000);
+    int n = 0;
+    int i = 0;
+    double secs = 0;
+
+    printf("----\nBENCH: List vs DEFINE_LIST on int64 values\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        int64_t *keys = malloc(n * sizeof(int64_t));
+        List *list = List_create();
+        int_list *typed = int_list_create();
+
+        srand(1);
+        for (i = 0; i < n; i++) {
+            keys[i] = ((int64_t)rand() << 31) ^ rand();
+            List_push(list, &keys[i]);
+        }
+        for (i = 0; i < n; i++) {
+            int_list_push(typed, keys[i]);
+        }
+
+        // the generic sort calls int64_compare through a pointer and
+        // loads every key through value; int_list does neither
+        BENCH(secs, List_merge_sort(list, int64_compare));
+        bench_report("List merge sort", n, secs);
+        BENCH(secs, int_list_merge_sort(typed));
+        bench_report("int_list merge sort", n, secs);
+
+        List_destroy(list);
+        int_list_destroy(typed);
+        free(keys);
+    }
+
+    return 0;
+}
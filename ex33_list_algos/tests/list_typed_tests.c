@@ -0,0 +1,146 @@
+#include "minunit.h"
+#include <lcthw/list_typed.h>
+#include <stdint.h>
+#include <string.h>
+
+DEFINE_LIST(int_list, int64_t, (a > b) - (a < b))
+
+// Compares on key only, so stability can be checked through id.
+typedef struct Record {
+    int key;
+    int id;
+} Record;
+
+DEFINE_LIST(record_list, Record, (a.key > b.key) - (a.key < b.key))
+
+DEFINE_LIST(word_list, const char *, strcmp(a, b))
+
+static int int_list_is_sorted(int_list * list)
+{
+    TLIST_FOREACH(int_list, list, first, next, cur) {
+        if (cur->next && cur->value > cur->next->value) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+char *test_push_pop()
+{
+    int_list *list = int_list_create();
+    int64_t out = 0;
+    int64_t i = 0;
+
+    for (i = 0; i < 10; i++) {
+        int_list_push(list, i);
+        int_list_unshift(list, -i);
+    }
+    mu_assert(list->count == 20, "Wrong count.");
+
+    mu_assert(int_list_pop(list, &out) == 0 && out == 9, "Wrong pop.");
+    mu_assert(int_list_shift(list, &out) == 0 && out == -9, "Wrong shift.");
+    while (int_list_pop(list, &out) == 0) {
+    }
+    mu_assert(list->count == 0 && list->first == NULL && list->last == NULL,
+            "List should be empty.");
+    mu_assert(int_list_shift(list, &out) == -1, "Shift of empty list.");
+
+    int_list_destroy(list);
+
+    return NULL;
+}
+
+char *test_merge_sort()
+{
+    int_list *list = int_list_create();
+    int i = 0;
+
+    mu_assert(int_list_merge_sort(list) == list, "Empty sort failed.");
+
+    srand(3);
+    for (i = 0; i < 10000; i++) {
+        int_list_push(list, (int64_t)rand() - RAND_MAX / 2);
+    }
+
+    int_list_merge_sort(list);
+    mu_assert(list->count == 10000, "Sort lost values.");
+    mu_assert(int_list_is_sorted(list), "Not sorted.");
+    mu_assert(list->first->prev == NULL && list->last->next == NULL,
+            "Ends not relinked.");
+
+    // prev links must be back in order too
+    int count = 0;
+    TLIST_FOREACH(int_list, list, last, prev, cur) {
+        count++;
+    }
+    mu_assert(count == 10000, "Backward walk is broken.");
+
+    int_list_destroy(list);
+
+    return NULL;
+}
+
+char *test_stable()
+{
+    record_list *list = record_list_create();
+    int i = 0;
+
+    for (i = 0; i < 1000; i++) {
+        Record rec = {.key = i % 7, .id = i };
+        record_list_push(list, rec);
+    }
+
+    record_list_merge_sort(list);
+    TLIST_FOREACH(record_list, list, first, next, cur) {
+        if (cur->next && cur->value.key == cur->next->value.key) {
+            mu_assert(cur->value.id < cur->next->value.id,
+                    "Equal keys changed order.");
+        }
+    }
+
+    record_list_destroy(list);
+
+    return NULL;
+}
+
+char *test_merge_find()
+{
+    word_list *left = word_list_create();
+    word_list *right = word_list_create();
+
+    word_list_push(left, "apple");
+    word_list_push(left, "pear");
+    word_list_push(right, "fig");
+    word_list_push(right, "plum");
+
+    word_list_merge(left, right);
+    mu_assert(left->count == 4 && right->count == 0, "Wrong merge counts.");
+    mu_assert(strcmp(left->first->next->value, "fig") == 0,
+            "Wrong merge order.");
+    mu_assert(left->last->prev->prev->value == left->first->next->value,
+            "Merge broke prev links.");
+
+    word_list_node *node = word_list_find(left, "pear");
+    mu_assert(node != NULL && node == left->last->prev, "Find failed.");
+    mu_assert(word_list_find(left, "kiwi") == NULL, "Found a missing word.");
+
+    word_list_destroy(left);
+    word_list_destroy(right);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_push_pop);
+    mu_run_test(test_merge_sort);
+    mu_run_test(test_stable);
+    mu_run_test(test_merge_find);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,115 @@
+#include <lcthw/cdarray.h>
+#include <lcthw/dbg.h>
+
+CDArray *CDArray_create()
+{
+    CDArray *array = calloc(1, sizeof(CDArray));
+    check_mem(array);
+
+    atomic_init(&array->end, 0);
+
+    return array;
+
+error:
+    return NULL;
+}
+
+void CDArray_destroy(CDArray * array)
+{
+    int k = 0;
+
+    if (array) {
+        for (k = 0; k < CDARRAY_CHUNKS; k++) {
+            free(atomic_load(&array->chunks[k]));
+        }
+        free(array);
+    }
+}
+
+void CDArray_clear_destroy(CDArray * array)
+{
+    int i = 0;
+
+    if (array) {
+        for (i = 0; i < CDArray_count(array); i++) {
+            free(CDArray_get(array, i));
+        }
+        CDArray_destroy(array);
+    }
+}
+
+// Maps index i to its chunk and the slot within it: adding
+// CDARRAY_FIRST makes the chunk the position of the top bit.
+static inline int CDArray_locate(int i, int *slot)
+{
+    unsigned int p = (unsigned int)i + CDARRAY_FIRST;
+    int top = 31 - __builtin_clz(p);
+
+    *slot = p - (1u << top);
+    return top - CDARRAY_FIRST_BITS;
+}
+
+static inline CDArraySlot *CDArray_chunk(CDArray * array, int k)
+{
+    CDArraySlot *chunk = atomic_load_explicit(&array->chunks[k],
+            memory_order_acquire);
+
+    if (chunk == NULL) {
+        // every pusher that finds the chunk missing races to install
+        // one; the losers free theirs and use the winner's
+        CDArraySlot *fresh = calloc((size_t)CDARRAY_FIRST << k,
+                sizeof(CDArraySlot));
+        check_mem(fresh);
+
+        if (atomic_compare_exchange_strong_explicit(&array->chunks[k],
+                    &chunk, fresh, memory_order_acq_rel,
+                    memory_order_acquire)) {
+            chunk = fresh;
+        } else {
+            free(fresh);
+        }
+    }
+
+    return chunk;
+
+error:
+    return NULL;
+}
+
+int CDArray_push(CDArray * array, void *el)
+{
+    int slot = 0;
+
+    check(el != NULL, "Can't push NULL, it marks unstored slots.");
+
+    int i = atomic_fetch_add_explicit(&array->end, 1, memory_order_relaxed);
+    check(i >= 0, "CDArray is full.");
+
+    CDArraySlot *chunk = CDArray_chunk(array, CDArray_locate(i, &slot));
+    check_mem(chunk);
+
+    // release pairs with the acquire in CDArray_get, so a reader that
+    // sees el also sees everything written to it before the push
+    atomic_store_explicit(&chunk[slot], el, memory_order_release);
+
+    return i;
+
+error:
+    return -1;
+}
+
+void *CDArray_get(CDArray * array, int i)
+{
+    int slot = 0;
+
+    if (i < 0 || i >= CDArray_count(array)) {
+        return NULL;
+    }
+
+    int k = CDArray_locate(i, &slot);
+    CDArraySlot *chunk = atomic_load_explicit(&array->chunks[k],
+            memory_order_acquire);
+
+    return chunk ? atomic_load_explicit(&chunk[slot],
+            memory_order_acquire) : NULL;
+}
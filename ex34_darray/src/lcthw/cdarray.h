@@ -0,0 +1,43 @@
+#ifndef _CDArray_h
+#define _CDArray_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+// Slots in the first chunk, as a power of two; chunk k holds
+// CDARRAY_FIRST << k slots.
+#define CDARRAY_FIRST_BITS 6
+#define CDARRAY_FIRST (1 << CDARRAY_FIRST_BITS)
+// Enough chunks to index every int.
+#define CDARRAY_CHUNKS (32 - CDARRAY_FIRST_BITS)
+
+typedef _Atomic(void *) CDArraySlot;
+
+// Append-only array that any number of threads can push to and read
+// from without a lock. A push claims its slot with one fetch-add on
+// end. Slots live in chunks that double in size and are never moved
+// or freed before CDArray_destroy, so growth is just installing the
+// next chunk (with a CAS, by whichever pusher gets there first) and a
+// reader can never see contents move under it.
+typedef struct CDArray {
+    atomic_int end;
+    _Atomic(CDArraySlot *) chunks[CDARRAY_CHUNKS];
+} CDArray;
+
+CDArray *CDArray_create();
+
+// Not thread safe: every other thread must be done with the array.
+void CDArray_destroy(CDArray * array);
+void CDArray_clear_destroy(CDArray * array);
+
+// Slots claimed so far. A slot below this can still read as NULL for
+// a moment, until its pusher has stored the element.
+#define CDArray_count(A) atomic_load(&(A)->end)
+
+// Appends el, which can't be NULL; returns its index or -1.
+int CDArray_push(CDArray * array, void *el);
+
+// The element at i, or NULL if i isn't stored yet.
+void *CDArray_get(CDArray * array, int i);
+
+#endif
@@ -1,19 +1,29 @@
 #include <lcthw/darray.h>
 #include <assert.h>
+#include <limits.h>
 
-DArray *DArray_create(size_t element_size, size_t initial_max)
+static inline DArray *DArray_create_mode(size_t element_size,
+        size_t initial_max, int value_mode, int pooled)
 {
     DArray *array = malloc(sizeof(DArray));
     check_mem(array);
     array->max = initial_max;
     check(array->max > 0, "You must set an initial_max > 0.");
 
-    array->contents = calloc(initial_max, sizeof(void *));
-    check_mem(array->contents);
-
     array->end = 0;
     array->element_size = element_size;
     array->expand_rate = DEFAULT_EXPAND_RATE;
+    array->grow = DArray_grow_double;
+    array->value_mode = value_mode;
+    array->pooled = pooled;
+    array->slabs = NULL;
+    array->free_elements = NULL;
+    array->slab_next = NULL;
+    array->slab_left = 0;
+    array->slab_size = DARRAY_MIN_SLAB;
+
+    array->contents = calloc(initial_max, DArray_slot_size(array));
+    check_mem(array->contents);
 
     return array;
 
@@ -23,16 +33,110 @@ error:
     return NULL;
 }
 
+DArray *DArray_create(size_t element_size, size_t initial_max)
+{
+    return DArray_create_mode(element_size, initial_max, 0, 0);
+}
+
+DArray *DArray_create_values(size_t element_size, size_t initial_max)
+{
+    check(element_size > 0, "Value arrays need an element_size > 0.");
+
+    return DArray_create_mode(element_size, initial_max, 1, 0);
+
+error:
+    return NULL;
+}
+
+DArray *DArray_create_pooled(size_t element_size, size_t initial_max)
+{
+    check(element_size > 0, "Pooled arrays need an element_size > 0.");
+
+    return DArray_create_mode(element_size, initial_max, 0, 1);
+
+error:
+    return NULL;
+}
+
+// Element slots hold at least the free list link and keep every
+// element aligned like malloc would.
+static inline size_t DArray_element_slot(DArray * array)
+{
+    size_t align = _Alignof(max_align_t);
+    size_t size = array->element_size < sizeof(void *) ?
+        sizeof(void *) : array->element_size;
+
+    return (size + align - 1) & ~(align - 1);
+}
+
+void *DArray_slab_alloc(DArray * array)
+{
+    size_t slot = DArray_element_slot(array);
+
+    if (array->slab_left == 0) {
+        DArraySlab *slab = malloc(sizeof(DArraySlab)
+                + array->slab_size * slot);
+        check_mem(slab);
+
+        slab->next = array->slabs;
+        array->slabs = slab;
+        array->slab_next = slab->elements;
+        array->slab_left = array->slab_size;
+
+        if (array->slab_size < DARRAY_MAX_SLAB) {
+            array->slab_size *= 2;
+        }
+    }
+
+    void *el = array->slab_next;
+    array->slab_next += slot;
+    array->slab_left--;
+
+    return el;
+
+error:
+    return NULL;
+}
+
+static inline void DArray_free_slabs(DArray * array)
+{
+    DArraySlab *slab = array->slabs;
+    while (slab) {
+        DArraySlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    array->slabs = NULL;
+    array->free_elements = NULL;
+    array->slab_next = NULL;
+    array->slab_left = 0;
+    array->slab_size = DARRAY_MIN_SLAB;
+}
+
 void DArray_clear(DArray * array)
 {
     int i = 0;
-    if (array->element_size > 0) {
+
+    if (array->pooled) {
+        // every element lives in a slab, so this is a free per slab
+        // rather than per element; DArray_set can store at end itself,
+        // but no slot past it is in use
+        int used = array->end < array->max ? array->end + 1 : array->max;
+        DArray_free_slabs(array);
+        memset(array->contents, 0, used * sizeof(void *));
+    } else if (!array->value_mode) {
         for (i = 0; i < array->max; i++) {
             if (array->contents[i] != NULL) {
-                free(array->contents[i]);
+                if (array->element_size > 0) {
+                    free(array->contents[i]);
+                }
+                array->contents[i] = NULL;
             }
         }
     }
+
+    array->end = 0;
 }
 
 static inline int DArray_resize(DArray * array, size_t newsize)
@@ -41,7 +145,7 @@ static inline int DArray_resize(DArray * array, size_t newsize)
     check(array->max > 0, "The newsize must be > 0.");
 
     void *contents = realloc(
-            array->contents, array->max * sizeof(void *));
+            array->contents, array->max * DArray_slot_size(array));
     // check contents and assume realloc doesn't harm the original on error
 
     check_mem(contents);
@@ -53,20 +157,53 @@ error:
     return -1;
 }
 
-int DArray_expand(DArray * array)
+size_t DArray_grow_double(DArray * array)
+{
+    return (size_t)array->max * 2;
+}
+
+size_t DArray_grow_by_half(DArray * array)
+{
+    return array->max + (array->max + 1) / 2;
+}
+
+size_t DArray_grow_fixed(DArray * array)
+{
+    return array->max + array->expand_rate;
+}
+
+// Resizes to new_max and clears any slots that were added.
+static inline int DArray_grow_to(DArray * array, size_t new_max)
 {
     size_t old_max = array->max;
-    check(DArray_resize(array, array->max + array->expand_rate) == 0,
-            "Failed to expand array to new size: %d",
-            array->max + (int)array->expand_rate);
+    check(new_max <= INT_MAX, "DArray can't hold %zu elements.", new_max);
+
+    check(DArray_resize(array, new_max) == 0,
+            "Failed to expand array to new size: %zu", new_max);
+
+    if (new_max > old_max) {
+        memset(DArray_at(array, old_max), 0,
+                (new_max - old_max) * DArray_slot_size(array));
+    }
 
-    memset(array->contents + old_max, 0, array->expand_rate + 1);
     return 0;
 
 error:
     return -1;
 }
 
+int DArray_expand(DArray * array)
+{
+    size_t new_max = array->grow(array);
+    check(new_max > (size_t)array->max,
+            "Growth policy didn't grow the array.");
+
+    return DArray_grow_to(array, new_max);
+
+error:
+    return -1;
+}
+
 int DArray_contract(DArray * array)
 {
     int new_size = array->end < (int)array->expand_rate ? 
@@ -75,9 +212,30 @@ int DArray_contract(DArray * array)
     return DArray_resize(array, new_size + 1);
 }
 
+int DArray_reserve(DArray * array, int n)
+{
+    check(n >= 0, "Can't reserve %d elements.", n);
+
+    // push needs the slot after the last element
+    if (n < array->max) {
+        return 0;
+    }
+
+    return DArray_grow_to(array, (size_t)n + 1);
+
+error:
+    return -1;
+}
+
+int DArray_shrink_to_fit(DArray * array)
+{
+    return DArray_resize(array, array->end + 1);
+}
+
 void DArray_destroy(DArray * array)
 {
     if (array) {
+        DArray_free_slabs(array);
         if (array->contents)
             free(array->contents);
         free(array);
@@ -90,8 +248,20 @@ void DArray_clear_destroy(DArray * array)
     DArray_destroy(array);
 }
 
+// Halves contents only once well under half full, and never below the
+// floor DArray_contract keeps.
+static inline void DArray_pop_shrink(DArray * array)
+{
+    if (DArray_end(array) < DArray_max(array) / DARRAY_SHRINK_DIVISOR
+            && DArray_max(array) / 2 > (int)array->expand_rate) {
+        DArray_resize(array, DArray_max(array) / 2);
+    }
+}
+
 int DArray_push(DArray * array, void *el)
 {
+    check(!array->value_mode, "DArray_push needs a pointer array.");
+
     array->contents[array->end] = el;
     array->end++;
 
@@ -100,21 +270,99 @@ int DArray_push(DArray * array, void *el)
     } else {
         return 0;
     }
+
+error:
+    return -1;
 }
 
 void *DArray_pop(DArray * array)
 {
+    check(!array->value_mode, "DArray_pop needs a pointer array.");
     check(array->end - 1 >= 0, "Attempt to pop from empty array.");
 
     void *el = DArray_remove(array, array->end - 1);
     array->end--;
 
-    if (DArray_end(array) > (int)array->expand_rate
-            && DArray_end(array) % array->expand_rate) {
-        DArray_contract(array);
-    }
+    DArray_pop_shrink(array);
 
     return el;
 error:
     return NULL;
+}
+
+int DArray_push_value(DArray * array, const void *value)
+{
+    check(array->value_mode, "DArray_push_value needs a value array.");
+
+    memcpy(DArray_at(array, array->end), value, array->element_size);
+    array->end++;
+
+    if (DArray_end(array) >= DArray_max(array)) {
+        return DArray_expand(array);
+    } else {
+        return 0;
+    }
+
+error:
+    return -1;
+}
+
+int DArray_pop_value(DArray * array, void *out)
+{
+    check(array->value_mode, "DArray_pop_value needs a value array.");
+    check(array->end - 1 >= 0, "Attempt to pop from empty array.");
+
+    array->end--;
+    if (out) {
+        memcpy(out, DArray_at(array, array->end), array->element_size);
+    }
+
+    DArray_pop_shrink(array);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int DArray_insert_value(DArray * array, int i, const void *value)
+{
+    check(array->value_mode, "DArray_insert_value needs a value array.");
+    check(i >= 0 && i <= array->end, "Insert at %d is out of bounds.", i);
+
+    // the slot at end is always free, so the tail fits shifted by one
+    memmove(DArray_at(array, i + 1), DArray_at(array, i),
+            (array->end - i) * array->element_size);
+    memcpy(DArray_at(array, i), value, array->element_size);
+    array->end++;
+
+    if (DArray_end(array) >= DArray_max(array)) {
+        return DArray_expand(array);
+    } else {
+        return 0;
+    }
+
+error:
+    return -1;
+}
+
+int DArray_remove_value(DArray * array, int i, void *out)
+{
+    check(array->value_mode, "DArray_remove_value needs a value array.");
+    check(i >= 0 && i < array->end, "Remove at %d is out of bounds.", i);
+
+    if (out) {
+        memcpy(out, DArray_at(array, i), array->element_size);
+    }
+
+    array->end--;
+    memmove(DArray_at(array, i), DArray_at(array, i + 1),
+            (array->end - i) * array->element_size);
+
+    DArray_pop_shrink(array);
+
+    return 0;
+
+error:
+    return -1;
 }
\ No newline at end of file
@@ -1,44 +1,131 @@
 #ifndef _DArray_h
 #define _DArray_h
 #include <stdlib.h>
+#include <stddef.h>
 #include <assert.h>
 #include <lcthw/dbg.h>
 
+struct DArray;
+
+#define DARRAY_MIN_SLAB 64
+#define DARRAY_MAX_SLAB 65536
+
+// A block of elements for DArray_new on a pooled array. Slabs double
+// in size from DARRAY_MIN_SLAB up to DARRAY_MAX_SLAB elements.
+typedef struct DArraySlab {
+    struct DArraySlab *next;
+    _Alignas(max_align_t) char elements[];
+} DArraySlab;
+
+// A growth policy returns the new max for an array that is full; it
+// must be larger than array->max. Set array->grow to one of the
+// DArray_grow_* policies below or to your own.
+typedef size_t (*DArray_grow_fn) (struct DArray * array);
+
 typedef struct DArray {
     int end;
     int max;
     size_t element_size;
     size_t expand_rate;
     void **contents;
+    DArray_grow_fn grow;
+    int value_mode;
+    int pooled;
+    DArraySlab *slabs;
+    void *free_elements;
+    char *slab_next;
+    int slab_left;
+    int slab_size;
 } DArray;
 
+// Doubles max, so n pushes cost O(n) copying in all. The default.
+size_t DArray_grow_double(DArray * array);
+
+// Grows max by half: more reallocs than doubling, less slack.
+size_t DArray_grow_by_half(DArray * array);
+
+// Adds expand_rate slots, which costs O(n^2) copying over n pushes
+// but never leaves more than expand_rate slots unused.
+size_t DArray_grow_fixed(DArray * array);
+
 DArray *DArray_create(size_t element_size, size_t initial_max);
 
+// Value mode: contents is one element_size * max buffer holding the
+// elements themselves, so there is no allocation per element and a
+// scan reads straight through memory. Use the _value functions and
+// DArray_at; the pointer functions (push, pop, get, set, new) are for
+// arrays made with DArray_create.
+DArray *DArray_create_values(size_t element_size, size_t initial_max);
+
+// Pooled mode: DArray_new carves elements from slabs the array owns
+// instead of calling calloc for each, and they belong to the array.
+// Hand one back with DArray_pool_free, never free(); DArray_clear and
+// DArray_destroy free them all a slab at a time, including any still
+// held elsewhere.
+DArray *DArray_create_pooled(size_t element_size, size_t initial_max);
+
 void DArray_destroy(DArray * array);
 
+// Frees the elements and empties the array, leaving every slot NULL.
+// Plain arrays free() each element in contents; pooled arrays drop
+// their slabs instead.
 void DArray_clear(DArray * array);
 
 int DArray_expand(DArray * array);
 
 int DArray_contract(DArray * array);
 
+// Makes room for n elements, so pushing up to n never reallocates.
+int DArray_reserve(DArray * array, int n);
+
+// Shrinks contents to the elements in use (plus the one free slot that
+// push needs).
+int DArray_shrink_to_fit(DArray * array);
+
 int DArray_push(DArray * array, void *el);
 
 void *DArray_pop(DArray * array);
 
 void DArray_clear_destroy(DArray * array);
 
-#define DArray_last(A) ((A)->contents[(A)->end - 1])
-#define DArray_first(A) ((A)->contents[0])
+// Copy element_size bytes in or out; out may be NULL. Insert and remove
+// shift the tail with memmove. All return 0 or -1.
+int DArray_push_value(DArray * array, const void *value);
+int DArray_pop_value(DArray * array, void *out);
+int DArray_insert_value(DArray * array, int i, const void *value);
+int DArray_remove_value(DArray * array, int i, void *out);
+
+#define DArray_last(A) DArray_get((A), (A)->end - 1)
+#define DArray_first(A) DArray_get((A), 0)
 #define DArray_end(A) ((A)->end)
 #define DArray_count(A) DArray_end(A)
 #define DArray_max(A) ((A)->max)
 
 #define DEFAULT_EXPAND_RATE 300
 
+// Pop halves max once the array is this many times smaller than max,
+// so alternating push and pop around a boundary can't thrash.
+#define DARRAY_SHRINK_DIVISOR 4
+
+// Bytes per slot in contents.
+static inline size_t DArray_slot_size(DArray * array)
+{
+    return array->value_mode ? array->element_size : sizeof(void *);
+}
+
+// Address of slot i, in either mode; in value mode the element itself.
+static inline void *DArray_at(DArray * array, int i)
+{
+    return (char *)array->contents + (size_t)i * DArray_slot_size(array);
+}
+
+// The pointer functions below, and push and pop, refuse value arrays:
+// their slots are element_size bytes, not pointers.
+
 static inline void DArray_set(DArray * array, int i, void *el)
 {
-    check(i < array->max, "darray attempt to set past max");
+    check(!array->value_mode, "DArray_set needs a pointer array.");
+    check(i >= 0 && i < array->max, "darray attempt to set past max");
     if (i > array->end)
         array->end = i;
     array->contents[i] = el;
@@ -48,7 +135,8 @@ error:
 
 static inline void *DArray_get(DArray * array, int i)
 {
-    check(i < array->max, "darray attempt to get past max");
+    check(!array->value_mode, "DArray_get needs a pointer array.");
+    check(i >= 0 && i < array->max, "darray attempt to get past max");
     return array->contents[i];
 error:
     return NULL;
@@ -56,19 +144,43 @@ error:
 
 static inline void *DArray_remove(DArray * array, int i)
 {
+    check(!array->value_mode, "DArray_remove needs a pointer array.");
+    check(i >= 0 && i < array->max, "darray attempt to remove past max");
+
     void *el = array->contents[i];
 
     array->contents[i] = NULL;
 
     return el;
+error:
+    return NULL;
 }
 
+// Carves a new element from a fresh slab; see DArray_new.
+void *DArray_slab_alloc(DArray * array);
+
+// Returns a zeroed element_size element: from calloc, or on a pooled
+// array from its slabs.
 static inline void *DArray_new(DArray * array)
 {
     check(array->element_size > 0,
             "Can't use DArray_new on 0 size darrays.");
+    check(!array->value_mode, "Value arrays hold elements in contents.");
 
-    return calloc(1, array->element_size);
+    if (!array->pooled) {
+        return calloc(1, array->element_size);
+    }
+
+    void *el = array->free_elements;
+    if (el) {
+        array->free_elements = *(void **)el;
+    } else {
+        el = DArray_slab_alloc(array);
+        check_mem(el);
+    }
+
+    memset(el, 0, array->element_size);
+    return el;
 
 error:
     return NULL;
@@ -76,4 +188,18 @@ error:
 
 #define DArray_free(E) free((E))
 
+// Hands an element of a pooled array back for DArray_new to reuse.
+static inline void DArray_pool_free(DArray * array, void *el)
+{
+    check(array->pooled, "DArray_pool_free needs a pooled array.");
+
+    if (el) {
+        *(void **)el = array->free_elements;
+        array->free_elements = el;
+    }
+
+error:
+    return;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include <lcthw/darray_algos.h>
+#include <string.h>
+
+// Swaps two slots; pointer sized ones (every pointer mode array) in
+// one move.
+static inline void DArray_swap(char *a, char *b, size_t size)
+{
+    if (size == sizeof(void *)) {
+        void *temp = NULL;
+        memcpy(&temp, a, sizeof(void *));
+        memcpy(a, b, sizeof(void *));
+        memcpy(b, &temp, sizeof(void *));
+        return;
+    }
+
+    char temp[64];
+    while (size > 0) {
+        size_t chunk = size < sizeof(temp) ? size : sizeof(temp);
+        memcpy(temp, a, chunk);
+        memcpy(a, b, chunk);
+        memcpy(b, temp, chunk);
+        a += chunk;
+        b += chunk;
+        size -= chunk;
+    }
+}
+
+static inline void DArray_insertion_sort(char *base, size_t n, size_t size,
+        DArray_compare cmp)
+{
+    size_t i = 0;
+    char *j = NULL;
+
+    for (i = 1; i < n; i++) {
+        for (j = base + i * size; j > base && cmp(j - size, j) > 0;
+                j -= size) {
+            DArray_swap(j - size, j, size);
+        }
+    }
+}
+
+static inline void DArray_sift_down(char *base, size_t root, size_t n,
+        size_t size, DArray_compare cmp)
+{
+    size_t child = 0;
+
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && cmp(base + child * size,
+                    base + (child + 1) * size) < 0) {
+            child++;
+        }
+
+        if (cmp(base + root * size, base + child * size) >= 0) {
+            return;
+        }
+
+        DArray_swap(base + root * size, base + child * size, size);
+        root = child;
+    }
+}
+
+static void DArray_heap(char *base, size_t n, size_t size,
+        DArray_compare cmp)
+{
+    size_t i = 0;
+
+    for (i = n / 2; i > 0; i--) {
+        DArray_sift_down(base, i - 1, n, size, cmp);
+    }
+
+    for (i = n - 1; i > 0; i--) {
+        DArray_swap(base, base + i * size, size);
+        DArray_sift_down(base, 0, i, size, cmp);
+    }
+}
+
+static void DArray_quick(char *base, size_t n, size_t size,
+        DArray_compare cmp, int depth)
+{
+    while (n > DARRAY_INSERTION_SORT) {
+        if (depth-- == 0) {
+            DArray_heap(base, n, size, cmp);
+            return;
+        }
+
+        // order first, middle, last, then park the median at base
+        char *mid = base + (n / 2) * size;
+        char *last = base + (n - 1) * size;
+        if (cmp(mid, base) < 0) {
+            DArray_swap(mid, base, size);
+        }
+        if (cmp(last, mid) < 0) {
+            DArray_swap(last, mid, size);
+            if (cmp(mid, base) < 0) {
+                DArray_swap(mid, base, size);
+            }
+        }
+        DArray_swap(base, mid, size);
+
+        // Hoare partition: both scans stop on elements equal to the
+        // pivot, so duplicates end up split between the two sides.
+        // last is >= pivot and base is the pivot, so neither scan can
+        // run off the range.
+        char *i = base;
+        char *j = base + n * size;
+        while (1) {
+            do {
+                i += size;
+            } while (cmp(i, base) < 0);
+            do {
+                j -= size;
+            } while (cmp(base, j) < 0);
+
+            if (i >= j) {
+                break;
+            }
+            DArray_swap(i, j, size);
+        }
+        DArray_swap(base, j, size);
+
+        // recurse into the smaller side, loop on the larger
+        size_t left = (j - base) / size;
+        size_t right = n - left - 1;
+        if (left < right) {
+            DArray_quick(base, left, size, cmp, depth);
+            base = j + size;
+            n = right;
+        } else {
+            DArray_quick(j + size, right, size, cmp, depth);
+            n = left;
+        }
+    }
+
+    DArray_insertion_sort(base, n, size, cmp);
+}
+
+int DArray_qsort(DArray * array, DArray_compare cmp)
+{
+    check(array && cmp, "array and cmp can't be NULL");
+
+    int depth = 0;
+    int n = 0;
+    for (n = DArray_count(array); n > 1; n /= 2) {
+        depth += 2;
+    }
+
+    DArray_quick(DArray_at(array, 0), DArray_count(array),
+            DArray_slot_size(array), cmp, depth);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int DArray_heapsort(DArray * array, DArray_compare cmp)
+{
+    check(array && cmp, "array and cmp can't be NULL");
+
+    if (DArray_count(array) > 1) {
+        DArray_heap(DArray_at(array, 0), DArray_count(array),
+                DArray_slot_size(array), cmp);
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+// Merges the sorted runs a[0, na) and b[0, nb) into out, ties to a.
+static inline void DArray_merge(char *a, size_t na, char *b, size_t nb,
+        char *out, size_t size, DArray_compare cmp)
+{
+    char *a_end = a + na * size;
+    char *b_end = b + nb * size;
+
+    // already in order: one copy
+    if (na == 0 || nb == 0 || cmp(a_end - size, b) <= 0) {
+        memcpy(out, a, na * size);
+        memcpy(out + na * size, b, nb * size);
+        return;
+    }
+
+    while (a < a_end && b < b_end) {
+        if (cmp(a, b) <= 0) {
+            memcpy(out, a, size);
+            a += size;
+        } else {
+            memcpy(out, b, size);
+            b += size;
+        }
+        out += size;
+    }
+
+    memcpy(out, a, a_end - a);
+    out += a_end - a;
+    memcpy(out, b, b_end - b);
+}
+
+int DArray_mergesort(DArray * array, DArray_compare cmp)
+{
+    char *temp = NULL;
+
+    check(array && cmp, "array and cmp can't be NULL");
+
+    size_t n = DArray_count(array);
+    size_t size = DArray_slot_size(array);
+    char *src = DArray_at(array, 0);
+    size_t width = 0;
+    size_t i = 0;
+
+    if (n <= 1) {
+        return 0;
+    }
+
+    for (i = 0; i < n; i += DARRAY_INSERTION_SORT) {
+        size_t run = n - i < DARRAY_INSERTION_SORT ?
+            n - i : DARRAY_INSERTION_SORT;
+        DArray_insertion_sort(src + i * size, run, size, cmp);
+    }
+
+    if (n <= DARRAY_INSERTION_SORT) {
+        return 0;
+    }
+
+    temp = malloc(n * size);
+    check_mem(temp);
+
+    // each pass merges pairs of runs from src into dst, then they swap
+    char *dst = temp;
+    for (width = DARRAY_INSERTION_SORT; width < n; width *= 2) {
+        for (i = 0; i < n; i += 2 * width) {
+            size_t na = n - i < width ? n - i : width;
+            size_t nb = n - i - na < width ? n - i - na : width;
+            DArray_merge(src + i * size, na, src + (i + na) * size, nb,
+                    dst + i * size, size, cmp);
+        }
+
+        char *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != DArray_at(array, 0)) {
+        memcpy(DArray_at(array, 0), src, n * size);
+    }
+
+    free(temp);
+    return 0;
+
+error:
+    return -1;
+}
+
+// The slot holding el for comparing; see darray_algos.h.
+static inline void *DArray_key(DArray * array, void **el)
+{
+    return array->value_mode ? *el : (void *)el;
+}
+
+// Index of the first element greater than key (or >= with or_equal).
+static inline int DArray_bound(DArray * array, void *key,
+        DArray_compare cmp, int or_equal)
+{
+    int lo = 0;
+    int hi = DArray_count(array);
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int rc = cmp(DArray_at(array, mid), key);
+
+        if (rc < 0 || (rc == 0 && !or_equal)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+int DArray_find(DArray * array, void *el, DArray_compare cmp)
+{
+    check(array && cmp, "array and cmp can't be NULL");
+
+    void *key = DArray_key(array, &el);
+    int i = DArray_bound(array, key, cmp, 1);
+
+    if (i < DArray_count(array) && cmp(DArray_at(array, i), key) == 0) {
+        return i;
+    }
+
+    return -1;
+
+error:
+    return -1;
+}
+
+int DArray_sort_add(DArray * array, void *el, DArray_compare cmp)
+{
+    check(array && cmp, "array and cmp can't be NULL");
+
+    int i = DArray_bound(array, DArray_key(array, &el), cmp, 0);
+
+    // push handles growth; then rotate the new last slot down to i,
+    // using the free slot at end as scratch
+    int rc = array->value_mode ? DArray_push_value(array, el)
+        : DArray_push(array, el);
+    check(rc == 0, "Failed to add element.");
+
+    size_t size = DArray_slot_size(array);
+    int end = DArray_end(array);
+    char *scratch = DArray_at(array, end);
+
+    memcpy(scratch, DArray_at(array, end - 1), size);
+    memmove(DArray_at(array, i + 1), DArray_at(array, i),
+            (end - 1 - i) * size);
+    memcpy(DArray_at(array, i), scratch, size);
+    memset(scratch, 0, size);
+
+    return 0;
+
+error:
+    return -1;
+}
@@ -0,0 +1,40 @@
+#ifndef _DArray_algos_h
+#define _DArray_algos_h
+
+#include <lcthw/darray.h>
+
+// Compares two slots of contents, like a qsort comparator: in pointer
+// mode a and b point at the element pointers, in value mode at the
+// elements themselves.
+typedef int (*DArray_compare) (const void *a, const void *b);
+
+// Ranges this short are finished by insertion sort.
+#define DARRAY_INSERTION_SORT 16
+
+// All sort the first DArray_count elements in place and return 0, or
+// -1 on error.
+
+// Quicksort with a median of three pivot and a partition that splits
+// runs of equal elements evenly; falls back to heapsort if it recurses
+// too deep, so it is O(n log n) worst case. Not stable.
+int DArray_qsort(DArray * array, DArray_compare cmp);
+
+// O(n log n) worst case and no extra memory. Not stable.
+int DArray_heapsort(DArray * array, DArray_compare cmp);
+
+// Stable bottom-up merge sort. Allocates one buffer the size of the
+// elements; merges of runs already in order are plain copies.
+int DArray_mergesort(DArray * array, DArray_compare cmp);
+
+// el is passed the way it would be to DArray_push (pointer mode) or
+// DArray_push_value (value mode).
+
+// Binary search of a sorted array. Returns the index of an element
+// equal to el, or -1.
+int DArray_find(DArray * array, void *el, DArray_compare cmp);
+
+// Inserts el after any equal elements so the array stays sorted.
+// Returns 0 or -1.
+int DArray_sort_add(DArray * array, void *el, DArray_compare cmp);
+
+#endif
@@ -0,0 +1,84 @@
+#include "bench.h"
+#include <lcthw/cdarray.h>
+#include <lcthw/darray.h>
+#include <pthread.h>
+
+#define MAX_THREADS 16
+
+// The baseline: a DArray behind one mutex, as the workers use it today.
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static DArray *locked = NULL;
+static CDArray *shared = NULL;
+static int per_thread = 0;
+
+static char *value = "bench";
+
+static void *locked_append(void *arg)
+{
+    int i = 0;
+    (void)arg;
+
+    for (i = 0; i < per_thread; i++) {
+        pthread_mutex_lock(&lock);
+        DArray_push(locked, value);
+        pthread_mutex_unlock(&lock);
+    }
+
+    return NULL;
+}
+
+static void *cdarray_append(void *arg)
+{
+    int i = 0;
+    (void)arg;
+
+    for (i = 0; i < per_thread; i++) {
+        CDArray_push(shared, value);
+    }
+
+    return NULL;
+}
+
+// Runs nthreads appenders adding n values in total.
+static double run_appenders(int nthreads, int n, void *(*append)(void *))
+{
+    pthread_t threads[MAX_THREADS];
+    double secs = 0;
+    int i = 0;
+
+    per_thread = n / nthreads;
+
+    BENCH(secs, {
+        for (i = 0; i < nthreads; i++) {
+            pthread_create(&threads[i], NULL, append, NULL);
+        }
+        for (i = 0; i < nthreads; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    });
+
+    return secs;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = bench_max_n(argc, argv, 10000000);
+    int nthreads = 0;
+    char name[64];
+
+    printf("----\nBENCH: CDArray vs mutex + DArray, concurrent append\n");
+
+    for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2) {
+        locked = DArray_create(0, 100);
+        snprintf(name, sizeof(name), "mutex DArray %d threads", nthreads);
+        bench_report(name, n, run_appenders(nthreads, n, locked_append));
+        DArray_destroy(locked);
+
+        shared = CDArray_create();
+        snprintf(name, sizeof(name), "CDArray %d threads", nthreads);
+        bench_report(name, n, run_appenders(nthreads, n, cdarray_append));
+        CDArray_destroy(shared);
+    }
+
+    return 0;
+}
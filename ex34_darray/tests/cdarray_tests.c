@@ -0,0 +1,155 @@
+#include "minunit.h"
+#include <lcthw/cdarray.h>
+#include <pthread.h>
+#include <stdint.h>
+
+static CDArray *array = NULL;
+
+char *test_create()
+{
+    array = CDArray_create();
+    mu_assert(array != NULL, "CDArray_create failed.");
+    mu_assert(CDArray_count(array) == 0, "New array isn't empty.");
+    mu_assert(CDArray_get(array, 0) == NULL, "Get past the end.");
+
+    return NULL;
+}
+
+char *test_push_get()
+{
+    intptr_t i = 0;
+
+    // far enough to cross several chunk boundaries
+    for (i = 0; i < 10000; i++) {
+        mu_assert(CDArray_push(array, (void *)(i + 1)) == i,
+                "Push returned the wrong index.");
+    }
+    mu_assert(CDArray_count(array) == 10000, "Wrong count.");
+
+    for (i = 0; i < 10000; i++) {
+        mu_assert(CDArray_get(array, i) == (void *)(i + 1),
+                "Wrong value.");
+    }
+    mu_assert(CDArray_get(array, -1) == NULL, "Get before the start.");
+    mu_assert(CDArray_push(array, NULL) == -1, "Pushed NULL.");
+
+    CDArray_destroy(array);
+
+    return NULL;
+}
+
+#define WRITERS 8
+#define PUSHES 100000
+
+// Writer w pushes w << 24 | n for n in 1..PUSHES.
+static void *writer(void *arg)
+{
+    intptr_t w = (intptr_t)arg;
+    intptr_t n = 0;
+
+    for (n = 1; n <= PUSHES; n++) {
+        if (CDArray_push(array, (void *)(w << 24 | n)) < 0) {
+            return (void *)1;
+        }
+    }
+
+    return NULL;
+}
+
+static atomic_int writing;
+
+// Keeps scanning while the writers run; every stored slot must hold a
+// value some writer pushed.
+static void *reader(void *arg)
+{
+    intptr_t bad = 0;
+    (void)arg;
+
+    while (atomic_load(&writing)) {
+        int count = CDArray_count(array);
+        int i = 0;
+
+        for (i = 0; i < count; i += 97) {
+            intptr_t v = (intptr_t)CDArray_get(array, i);
+            if (v != 0 && ((v >> 24) >= WRITERS || (v & 0xffffff) == 0
+                        || (v & 0xffffff) > PUSHES)) {
+                bad++;
+            }
+        }
+    }
+
+    return (void *)bad;
+}
+
+char *test_stress()
+{
+    pthread_t writers[WRITERS];
+    pthread_t scanner;
+    intptr_t last[WRITERS] = { 0 };
+    intptr_t w = 0;
+    int i = 0;
+
+    array = CDArray_create();
+    atomic_init(&writing, 1);
+    mu_assert(pthread_create(&scanner, NULL, reader, NULL) == 0,
+            "Failed to start reader.");
+
+    for (w = 0; w < WRITERS; w++) {
+        mu_assert(pthread_create(&writers[w], NULL, writer, (void *)w) == 0,
+                "Failed to start writer.");
+    }
+    for (w = 0; w < WRITERS; w++) {
+        void *rc = NULL;
+        pthread_join(writers[w], &rc);
+        mu_assert(rc == NULL, "A push failed.");
+    }
+
+    atomic_store(&writing, 0);
+    void *bad = NULL;
+    pthread_join(scanner, &bad);
+    mu_assert(bad == NULL, "Reader saw a value nobody pushed.");
+
+    mu_assert(CDArray_count(array) == WRITERS * PUSHES, "Lost pushes.");
+
+    // each writer's values are all there, once, in the order pushed
+    for (i = 0; i < CDArray_count(array); i++) {
+        intptr_t v = (intptr_t)CDArray_get(array, i);
+        mu_assert(v != 0, "Slot left empty.");
+
+        w = v >> 24;
+        mu_assert((v & 0xffffff) == last[w] + 1,
+                "A writer's values are out of order.");
+        last[w]++;
+    }
+    for (w = 0; w < WRITERS; w++) {
+        mu_assert(last[w] == PUSHES, "A writer's values are missing.");
+    }
+
+    CDArray_destroy(array);
+
+    return NULL;
+}
+
+char *test_clear_destroy()
+{
+    array = CDArray_create();
+    CDArray_push(array, malloc(8));
+    CDArray_push(array, malloc(8));
+    CDArray_clear_destroy(array);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_get);
+    mu_run_test(test_stress);
+    mu_run_test(test_clear_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,73 @@
+#include "bench.h"
+#include <lcthw/darray_algos.h>
+#include <stdint.h>
+#include <string.h>
+
+static int int64_compare(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static const char *shapes[] = { "random", "sorted", "duplicates" };
+
+static void fill(DArray * array, int n, int shape)
+{
+    int64_t i = 0;
+
+    srand(1);
+    array->end = 0;
+    for (i = 0; i < n; i++) {
+        int64_t value = shape == 0 ? ((int64_t)rand() << 31) ^ rand()
+            : shape == 1 ? i : rand() % 16;
+        DArray_push_value(array, &value);
+    }
+}
+
+static int libc_qsort(DArray * array, DArray_compare cmp)
+{
+    qsort(array->contents, DArray_count(array), array->element_size, cmp);
+    return 0;
+}
+
+static const struct {
+    const char *name;
+    int (*sort) (DArray * array, DArray_compare cmp);
+} sorts[] = {
+    {"libc qsort", libc_qsort},
+    {"DArray_qsort", DArray_qsort},
+    {"DArray_heapsort", DArray_heapsort},
+    {"DArray_mergesort", DArray_mergesort},
+};
+
+#define NUM_SORTS (int)(sizeof(sorts) / sizeof(sorts[0]))
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 1000000);
+    DArray *array = DArray_create_values(sizeof(int64_t), 100);
+    char name[64];
+    double secs = 0;
+    int shape = 0;
+    int s = 0;
+    int n = 0;
+
+    printf("----\nBENCH: DArray sorts vs libc qsort on int64 values\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        for (shape = 0; shape < 3; shape++) {
+            for (s = 0; s < NUM_SORTS; s++) {
+                fill(array, n, shape);
+                BENCH(secs, sorts[s].sort(array, int64_compare));
+                snprintf(name, sizeof(name), "%s %s", sorts[s].name,
+                        shapes[shape]);
+                bench_report(name, n, secs);
+            }
+        }
+    }
+
+    DArray_destroy(array);
+
+    return 0;
+}
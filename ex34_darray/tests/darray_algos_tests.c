@@ -0,0 +1,204 @@
+#include "minunit.h"
+#include <lcthw/darray_algos.h>
+#include <string.h>
+
+typedef int (*DArray_sort) (DArray * array, DArray_compare cmp);
+
+static int testcmp(char **a, char **b)
+{
+    return strcmp(*a, *b);
+}
+
+static int intcmp(const int *a, const int *b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+// Orders by key only, so stability shows in id.
+typedef struct Record {
+    int key;
+    int id;
+} Record;
+
+static int recordcmp(const Record * a, const Record * b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+static DArray *create_words()
+{
+    DArray *result = DArray_create(0, 5);
+    char *words[] = { "asdfasfd", "werwar", "13234", "asdfasfd", "oioj" };
+    int i = 0;
+
+    for (i = 0; i < 5; i++) {
+        DArray_push(result, words[i]);
+    }
+
+    return result;
+}
+
+static int is_sorted(DArray * array)
+{
+    int i = 0;
+
+    for (i = 0; i < DArray_count(array) - 1; i++) {
+        if (strcmp(DArray_get(array, i), DArray_get(array, i + 1)) > 0) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// 0 random, 1 sorted, 2 reversed, 3 few distinct values
+static DArray *create_ints(int n, int shape)
+{
+    DArray *ints = DArray_create_values(sizeof(int), 16);
+    int i = 0;
+
+    srand(shape + 1);
+    for (i = 0; i < n; i++) {
+        int value = shape == 0 ? rand() : shape == 1 ? i
+            : shape == 2 ? n - i : rand() % 4;
+        DArray_push_value(ints, &value);
+    }
+
+    return ints;
+}
+
+static char *run_sort_test(DArray_sort func, const char *name)
+{
+    DArray *words = create_words();
+    mu_assert(!is_sorted(words), "Words should start not sorted.");
+
+    debug("--- Testing %s sorting algorithm", name);
+    int rc = func(words, (DArray_compare) testcmp);
+    mu_assert(rc == 0, "sort failed");
+    mu_assert(is_sorted(words), "didn't sort it");
+
+    DArray_destroy(words);
+
+    int shape = 0;
+    int n = 0;
+    for (shape = 0; shape < 4; shape++) {
+        for (n = 0; n <= 3000; n = n * 3 + 1) {
+            DArray *ints = create_ints(n, shape);
+            mu_assert(func(ints, (DArray_compare) intcmp) == 0,
+                    "int sort failed");
+
+            int i = 0;
+            for (i = 1; i < n; i++) {
+                mu_assert(*(int *)DArray_at(ints, i - 1) <=
+                        *(int *)DArray_at(ints, i), "ints not sorted");
+            }
+
+            DArray_destroy(ints);
+        }
+    }
+
+    return NULL;
+}
+
+char *test_qsort()
+{
+    return run_sort_test(DArray_qsort, "qsort");
+}
+
+char *test_heapsort()
+{
+    return run_sort_test(DArray_heapsort, "heapsort");
+}
+
+char *test_mergesort()
+{
+    return run_sort_test(DArray_mergesort, "mergesort");
+}
+
+char *test_mergesort_stable()
+{
+    DArray *records = DArray_create_values(sizeof(Record), 16);
+    int i = 0;
+
+    for (i = 0; i < 1000; i++) {
+        Record rec = {.key = (i * 7919) % 13, .id = i };
+        DArray_push_value(records, &rec);
+    }
+
+    DArray_mergesort(records, (DArray_compare) recordcmp);
+    for (i = 1; i < 1000; i++) {
+        Record *a = DArray_at(records, i - 1);
+        Record *b = DArray_at(records, i);
+        mu_assert(a->key < b->key || (a->key == b->key && a->id < b->id),
+                "Merge sort isn't stable.");
+    }
+
+    DArray_destroy(records);
+
+    return NULL;
+}
+
+char *test_find_sort_add()
+{
+    DArray *words = create_words();
+    DArray_qsort(words, (DArray_compare) testcmp);
+
+    mu_assert(DArray_find(words, "oioj", (DArray_compare) testcmp) == 3,
+            "Wrong index for found word.");
+    mu_assert(DArray_find(words, "zzz", (DArray_compare) testcmp) == -1,
+            "Found a missing word.");
+
+    // max is 5 + 1, so these also grow the array
+    char *more[] = { "0000", "zzzz", "mmmm", "asdfasfd", "werwar" };
+    int i = 0;
+    for (i = 0; i < 5; i++) {
+        mu_assert(DArray_sort_add(words, more[i],
+                    (DArray_compare) testcmp) == 0, "sort_add failed");
+        mu_assert(is_sorted(words), "sort_add broke the order");
+    }
+    mu_assert(DArray_count(words) == 10, "Wrong count after sort_add.");
+    mu_assert(DArray_get(words, 3) == more[3],
+            "Equal element should go after the others.");
+    mu_assert(DArray_get(words, DArray_end(words)) == NULL,
+            "Scratch slot wasn't cleared.");
+
+    DArray_destroy(words);
+
+    // value mode: the element is passed by address
+    DArray *ints = DArray_create_values(sizeof(int), 4);
+    for (i = 0; i < 200; i++) {
+        int value = (i * 37) % 101;
+        DArray_sort_add(ints, &value, (DArray_compare) intcmp);
+    }
+    for (i = 1; i < 200; i++) {
+        mu_assert(*(int *)DArray_at(ints, i - 1) <=
+                *(int *)DArray_at(ints, i), "sort_add values not sorted");
+    }
+
+    int want = 55;
+    i = DArray_find(ints, &want, (DArray_compare) intcmp);
+    mu_assert(i >= 0 && *(int *)DArray_at(ints, i) == 55,
+            "Didn't find value.");
+    want = 500;
+    mu_assert(DArray_find(ints, &want, (DArray_compare) intcmp) == -1,
+            "Found a missing value.");
+
+    DArray_destroy(ints);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_qsort);
+    mu_run_test(test_heapsort);
+    mu_run_test(test_mergesort);
+    mu_run_test(test_mergesort_stable);
+    mu_run_test(test_find_sort_add);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,138 @@
+#include "bench.h"
+#include <lcthw/darray.h>
+#include <stdint.h>
+
+static char *value = "bench";
+static int resizes = 0;
+static DArray_grow_fn policy = NULL;
+
+// Counts expansions on the way through to the policy under test.
+static size_t counted_grow(DArray * array)
+{
+    resizes++;
+    return policy(array);
+}
+
+static const struct {
+    const char *name;
+    DArray_grow_fn grow;
+} policies[] = {
+    {"fixed 300", DArray_grow_fixed},
+    {"by half", DArray_grow_by_half},
+    {"double", DArray_grow_double},
+};
+
+#define NUM_POLICIES (int)(sizeof(policies) / sizeof(policies[0]))
+
+static void bench_push_pop(const char *name, DArray_grow_fn grow, int n,
+        int reserve)
+{
+    DArray *array = DArray_create(0, 100);
+    char label[64];
+    double secs = 0;
+    int i = 0;
+
+    policy = grow;
+    array->grow = counted_grow;
+    resizes = 0;
+
+    BENCH(secs, {
+        if (reserve) {
+            DArray_reserve(array, n);
+        }
+        for (i = 0; i < n; i++) {
+            DArray_push(array, value);
+        }
+    });
+    snprintf(label, sizeof(label), "push %s%s", name,
+            reserve ? " reserved" : "");
+    bench_report(label, n, secs);
+    printf("%-28s %d expansions\n", "", resizes);
+
+    BENCH(secs, for (i = 0; i < n; i++) DArray_pop(array));
+    snprintf(label, sizeof(label), "pop %s", name);
+    bench_report(label, n, secs);
+
+    DArray_destroy(array);
+}
+
+// Sums n int64s kept behind pointers and then stored by value.
+static void bench_scan(int n)
+{
+    DArray *pointers = DArray_create(sizeof(int64_t), 100);
+    DArray *pooled = DArray_create_pooled(sizeof(int64_t), 100);
+    DArray *values = DArray_create_values(sizeof(int64_t), 100);
+    int64_t sum = 0;
+    double secs = 0;
+    int64_t i = 0;
+
+    BENCH(secs, {
+        for (i = 0; i < n; i++) {
+            int64_t *el = DArray_new(pointers);
+            *el = i;
+            DArray_push(pointers, el);
+        }
+    });
+    bench_report("pointer fill", n, secs);
+    BENCH(secs, {
+        for (i = 0; i < n; i++) {
+            int64_t *el = DArray_new(pooled);
+            *el = i;
+            DArray_push(pooled, el);
+        }
+    });
+    bench_report("pooled fill", n, secs);
+    BENCH(secs, {
+        for (i = 0; i < n; i++) {
+            DArray_push_value(values, &i);
+        }
+    });
+    bench_report("value fill", n, secs);
+
+    BENCH(secs, {
+        for (i = 0; i < n; i++) {
+            sum += *(int64_t *)DArray_get(pointers, i);
+        }
+    });
+    bench_report("pointer scan", n, secs);
+    BENCH(secs, {
+        int64_t *el = DArray_at(values, 0);
+        for (i = 0; i < n; i++) {
+            sum += el[i];
+        }
+    });
+    bench_report("value scan", n, secs);
+
+    BENCH(secs, DArray_clear_destroy(pointers));
+    bench_report("pointer clear_destroy", n, secs);
+    BENCH(secs, DArray_clear_destroy(pooled));
+    bench_report("pooled clear_destroy", n, secs);
+    DArray_clear_destroy(values);
+
+    // keeps the scans from being optimized away
+    printf("%-28s checksum %lld\n", "", (long long)sum);
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 10000000);
+    int n = 0;
+    int p = 0;
+
+    printf("----\nBENCH: DArray push/pop by growth policy\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        for (p = 0; p < NUM_POLICIES; p++) {
+            bench_push_pop(policies[p].name, policies[p].grow, n, 0);
+        }
+        bench_push_pop("fixed 300", DArray_grow_fixed, n, 1);
+    }
+
+    printf("----\nBENCH: DArray scan, pointer vs value mode\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        bench_scan(n);
+    }
+
+    return 0;
+}
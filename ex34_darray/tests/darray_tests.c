@@ -1,5 +1,6 @@
 #include "minunit.h"
 #include <lcthw/darray.h>
+#include <stddef.h>
 
 static DArray *array = NULL;
 static int *val1 = NULL;
@@ -71,6 +72,8 @@ char *test_remove()
 
 char *test_expand_contract()
 {
+    // these sizes assume the fixed step
+    array->grow = DArray_grow_fixed;
     int old_max = array->max;
     DArray_expand(array);
     mu_assert((unsigned int)array->max == old_max + array->expand_rate,
@@ -108,6 +111,260 @@ char *test_push_pop()
     return NULL;
 }
 
+static size_t grow_by_ten(DArray * array)
+{
+    return array->max + 10;
+}
+
+char *test_growth_policies()
+{
+    DArray *grown = DArray_create(0, 10);
+    int i = 0;
+
+    for (i = 0; i < 100; i++) {
+        DArray_push(grown, &val1);
+    }
+    mu_assert(grown->max == 160, "Default growth should double.");
+
+    grown->grow = DArray_grow_by_half;
+    DArray_expand(grown);
+    mu_assert(grown->max == 240, "Wrong size growing by half.");
+
+    grown->grow = grow_by_ten;
+    DArray_expand(grown);
+    mu_assert(grown->max == 250, "Callback policy not used.");
+    mu_assert(DArray_get(grown, 249) == NULL, "New slots aren't cleared.");
+    mu_assert(DArray_get(grown, 99) == &val1, "Expand lost values.");
+
+    DArray_destroy(grown);
+
+    return NULL;
+}
+
+char *test_reserve_shrink()
+{
+    DArray *reserved = DArray_create(0, 10);
+    int i = 0;
+
+    mu_assert(DArray_reserve(reserved, 5000) == 0, "Reserve failed.");
+    int max = reserved->max;
+    mu_assert(max > 5000, "Reserve didn't make room.");
+    for (i = 0; i < 5000; i++) {
+        DArray_push(reserved, &val1);
+    }
+    mu_assert(reserved->max == max, "Pushing into reserved room grew.");
+    mu_assert(DArray_reserve(reserved, 10) == 0 && reserved->max == max,
+            "Reserving less shouldn't shrink.");
+
+    DArray_pop(reserved);
+    mu_assert(DArray_shrink_to_fit(reserved) == 0, "Shrink failed.");
+    mu_assert(reserved->max == 5000, "Wrong size after shrink_to_fit.");
+    DArray_push(reserved, &val2);
+    mu_assert(DArray_last(reserved) == &val2, "Push after shrink failed.");
+
+    DArray_destroy(reserved);
+
+    return NULL;
+}
+
+char *test_pop_hysteresis()
+{
+    DArray *churn = DArray_create(0, 10);
+    int i = 0;
+
+    for (i = 0; i < 100000; i++) {
+        DArray_push(churn, &val1);
+    }
+    int max = churn->max;
+
+    // nothing shrinks until the array is down to max / DIVISOR
+    while (DArray_count(churn) > max / DARRAY_SHRINK_DIVISOR) {
+        DArray_pop(churn);
+    }
+    mu_assert(churn->max == max, "Shrunk before reaching the boundary.");
+
+    // push/pop across that boundary shrinks once, then leaves contents
+    // alone
+    int resizes = 0;
+    int last_max = max;
+    for (i = 0; i < 1000; i++) {
+        DArray_pop(churn);
+        resizes += churn->max != last_max;
+        last_max = churn->max;
+
+        DArray_push(churn, &val1);
+        resizes += churn->max != last_max;
+        last_max = churn->max;
+    }
+    mu_assert(resizes == 1 && churn->max == max / 2,
+            "Push/pop churn at the boundary resized more than once.");
+    max = churn->max;
+
+    while (DArray_count(churn) > 0) {
+        DArray_pop(churn);
+    }
+    mu_assert(churn->max < max / DARRAY_SHRINK_DIVISOR,
+            "Popping everything should shrink.");
+    mu_assert(churn->max > (int)churn->expand_rate,
+            "Shrunk below the floor.");
+
+    DArray_destroy(churn);
+
+    return NULL;
+}
+
+char *test_values()
+{
+    DArray *values = DArray_create_values(sizeof(int), 4);
+    int i = 0;
+    int out = 0;
+
+    mu_assert(values != NULL, "DArray_create_values failed.");
+    mu_assert(DArray_create_values(0, 4) == NULL,
+            "Value arrays need an element size.");
+
+    for (i = 0; i < 1000; i++) {
+        mu_assert(DArray_push_value(values, &i) == 0, "Push failed.");
+    }
+    mu_assert(DArray_count(values) == 1000, "Wrong count after push.");
+    for (i = 0; i < 1000; i++) {
+        mu_assert(*(int *)DArray_at(values, i) == i, "Wrong value.");
+    }
+    mu_assert((int *)DArray_at(values, 999) == (int *)values->contents + 999,
+            "Values aren't contiguous.");
+
+    out = -1;
+    mu_assert(DArray_insert_value(values, 0, &out) == 0, "Insert failed.");
+    out = 5000;
+    DArray_insert_value(values, 500, &out);
+    DArray_insert_value(values, DArray_count(values), &out);
+    mu_assert(DArray_count(values) == 1003, "Wrong count after insert.");
+    mu_assert(*(int *)DArray_at(values, 0) == -1 &&
+            *(int *)DArray_at(values, 1) == 0 &&
+            *(int *)DArray_at(values, 500) == 5000 &&
+            *(int *)DArray_at(values, 501) == 499 &&
+            *(int *)DArray_at(values, 1002) == 5000,
+            "Insert didn't shift the tail.");
+    mu_assert(DArray_insert_value(values, 2000, &out) == -1,
+            "Insert past the end should fail.");
+
+    mu_assert(DArray_remove_value(values, 500, &out) == 0 && out == 5000,
+            "Wrong removed value.");
+    DArray_remove_value(values, 0, NULL);
+    DArray_remove_value(values, DArray_count(values) - 1, NULL);
+    for (i = 0; i < 1000; i++) {
+        mu_assert(*(int *)DArray_at(values, i) == i,
+                "Remove didn't close the gap.");
+    }
+
+    for (i = 999; i >= 0; i--) {
+        mu_assert(DArray_pop_value(values, &out) == 0 && out == i,
+                "Wrong value on pop.");
+    }
+    mu_assert(DArray_pop_value(values, &out) == -1, "Pop of empty array.");
+
+    // the pointer functions would treat int slots as pointers
+    DArray_push_value(values, &i);
+    mu_assert(DArray_push(values, &out) == -1 &&
+            DArray_pop(values) == NULL &&
+            DArray_get(values, 0) == NULL &&
+            DArray_remove(values, 0) == NULL &&
+            DArray_last(values) == NULL,
+            "Pointer functions should refuse a value array.");
+    DArray_set(values, 0, &out);
+    mu_assert(DArray_count(values) == 1 &&
+            *(int *)DArray_at(values, 0) == i,
+            "Pointer functions changed a value array.");
+    DArray_pop_value(values, NULL);
+
+    // clear has nothing to free in value mode
+    DArray_push_value(values, &i);
+    DArray_clear_destroy(values);
+
+    return NULL;
+}
+
+char *test_clear()
+{
+    DArray *owned = DArray_create(sizeof(int), 10);
+    int i = 0;
+
+    // plain arrays free what was pushed, however it was allocated
+    for (i = 0; i < 20; i++) {
+        int *el = i % 2 ? DArray_new(owned) : malloc(sizeof(int));
+        DArray_push(owned, el);
+    }
+    DArray_clear(owned);
+    mu_assert(DArray_count(owned) == 0, "Clear should empty the array.");
+    for (i = 0; i < DArray_max(owned); i++) {
+        mu_assert(DArray_get(owned, i) == NULL,
+                "Clear left a freed pointer behind.");
+    }
+
+    // and destroy leaves elements with the caller
+    int *kept = DArray_new(owned);
+    *kept = 42;
+    DArray_push(owned, kept);
+    DArray_destroy(owned);
+    mu_assert(*kept == 42, "Destroy freed a plain array's element.");
+    DArray_free(kept);
+
+    DArray *pointers = DArray_create(0, 10);
+    DArray_push(pointers, &val1);
+    DArray_clear(pointers);
+    mu_assert(DArray_count(pointers) == 0 && DArray_get(pointers, 0) == NULL,
+            "Clear should empty a 0 size array too.");
+    DArray_destroy(pointers);
+
+    return NULL;
+}
+
+char *test_element_pool()
+{
+    mu_assert(DArray_create_pooled(0, 100) == NULL,
+            "Pooled arrays need an element size.");
+
+    DArray *pooled = DArray_create_pooled(sizeof(int), 100);
+    int i = 0;
+
+    for (i = 0; i < 100000; i++) {
+        int *el = DArray_new(pooled);
+        mu_assert(el != NULL && *el == 0, "New element isn't zeroed.");
+        mu_assert((size_t)el % _Alignof(max_align_t) == 0,
+                "Element isn't aligned.");
+        *el = i;
+        DArray_push(pooled, el);
+    }
+
+    int slabs = 0;
+    DArraySlab *slab = NULL;
+    for (slab = pooled->slabs; slab != NULL; slab = slab->next) {
+        slabs++;
+    }
+    mu_assert(slabs < 20, "Elements should come from a few large slabs.");
+
+    // a freed element is the next one handed out
+    int *last = DArray_pop(pooled);
+    mu_assert(*last == 99999, "Wrong value on pop.");
+    DArray_pool_free(pooled, last);
+    mu_assert(DArray_new(pooled) == last, "Freed element wasn't reused.");
+
+    DArray_clear(pooled);
+    mu_assert(DArray_count(pooled) == 0 && pooled->slabs == NULL,
+            "Clear should drop every slab.");
+    mu_assert(DArray_get(pooled, 0) == NULL &&
+            DArray_get(pooled, 99998) == NULL,
+            "Clear left a pointer into a freed slab.");
+
+    int *el = DArray_new(pooled);
+    DArray_push(pooled, el);
+    mu_assert(DArray_count(pooled) == 1, "Array unusable after clear.");
+
+    DArray_clear_destroy(pooled);
+
+    return NULL;
+}
+
 char *all_tests()
 {
     mu_suite_start();
@@ -119,6 +376,12 @@ char *all_tests()
     mu_run_test(test_remove);
     mu_run_test(test_expand_contract);
     mu_run_test(test_push_pop);
+    mu_run_test(test_growth_policies);
+    mu_run_test(test_reserve_shrink);
+    mu_run_test(test_pop_hysteresis);
+    mu_run_test(test_values);
+    mu_run_test(test_clear);
+    mu_run_test(test_element_pool);
     mu_run_test(test_destroy);
 
     return NULL;
@@ -0,0 +1,15 @@
+echo "Running benchmarks:"
+
+for i in tests/*_bench
+do
+    if test -f $i
+    then
+        if ! ./$i $BENCH_ARGS
+        then
+            echo "ERROR in benchmark $i"
+            exit 1
+        fi
+    fi
+done
+
+echo ""
@@ -0,0 +1,380 @@
+#include <lcthw/clist.h>
+#include <lcthw/thread_slot.h>
+#include <lcthw/dbg.h>
+#include <sched.h>
+
+static inline void CListNode_lock(CListNode * node)
+{
+    while (atomic_flag_test_and_set_explicit(&node->lock,
+                memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+static inline void CListNode_unlock(CListNode * node)
+{
+    atomic_flag_clear_explicit(&node->lock, memory_order_release);
+}
+
+static inline void CListNode_init(CListNode * node, void *value)
+{
+    atomic_init(&node->next, NULL);
+    atomic_init(&node->prev, NULL);
+    atomic_init(&node->removed, 0);
+    atomic_flag_clear(&node->lock);
+    node->value = value;
+    node->retired_epoch = 0;
+    node->retired_next = NULL;
+}
+
+// Called when a thread that read the list exits.
+static void CListReader_release(void *data)
+{
+    CListReader *reader = data;
+
+    reader->nesting = 0;
+    atomic_store(&reader->epoch, 0);
+    atomic_store(&reader->active, 0);
+}
+
+CList *CList_create()
+{
+    CList *list = calloc(1, sizeof(CList));
+    check_mem(list);
+
+    pthread_mutex_init(&list->retire_lock, NULL);
+
+    CListNode_init(&list->head, NULL);
+    CListNode_init(&list->tail, NULL);
+    atomic_store(&list->head.next, &list->tail);
+    atomic_store(&list->tail.prev, &list->head);
+
+    atomic_init(&list->count, 0);
+    atomic_init(&list->epoch, 1);
+    atomic_init(&list->readers, NULL);
+
+    return list;
+
+error:
+    free(list);
+    return NULL;
+}
+
+void CList_destroy(CList * list)
+{
+    check(list, "List is NULL");
+
+    ThreadSlot_drop(list);
+    pthread_mutex_destroy(&list->retire_lock);
+
+    CListNode *node = atomic_load(&list->head.next);
+    while (node != &list->tail) {
+        CListNode *next = atomic_load(&node->next);
+        free(node);
+        node = next;
+    }
+
+    node = list->retired;
+    while (node) {
+        CListNode *next = node->retired_next;
+        free(node);
+        node = next;
+    }
+
+    CListReader *reader = atomic_load(&list->readers);
+    while (reader) {
+        CListReader *next = reader->next;
+        free(reader);
+        reader = next;
+    }
+
+    free(list);
+
+error:
+    return;
+}
+
+// Finds this thread's reader, taking over an idle one or adding a new
+// one the first time the thread reads the list.
+static inline CListReader *CList_reader(CList * list)
+{
+    CListReader *reader = ThreadSlot_get(list);
+    if (reader) {
+        return reader;
+    }
+
+    for (reader = atomic_load(&list->readers); reader != NULL;
+            reader = reader->next) {
+        int idle = 0;
+        if (atomic_load(&reader->active) == 0
+                && atomic_compare_exchange_strong(&reader->active, &idle, 1)) {
+            break;
+        }
+    }
+
+    if (reader == NULL) {
+        reader = calloc(1, sizeof(CListReader));
+        check_mem(reader);
+        atomic_init(&reader->active, 1);
+        atomic_init(&reader->epoch, 0);
+
+        CListReader *first = atomic_load(&list->readers);
+        do {
+            reader->next = first;
+        } while (!atomic_compare_exchange_weak(&list->readers, &first,
+                    reader));
+    }
+
+    check(ThreadSlot_set(list, reader, CListReader_release) == 0,
+            "Failed to set thread reader.");
+
+    return reader;
+
+error:
+    if (reader) {
+        atomic_store(&reader->active, 0);
+    }
+    return NULL;
+}
+
+int CList_read_lock(CList * list)
+{
+    CListReader *reader = CList_reader(list);
+    check(reader, "Failed to get a reader.");
+
+    if (reader->nesting++ == 0) {
+        atomic_store(&reader->epoch, atomic_load(&list->epoch));
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+void CList_read_unlock(CList * list)
+{
+    CListReader *reader = ThreadSlot_get(list);
+
+    if (reader && reader->nesting > 0 && --reader->nesting == 0) {
+        atomic_store(&reader->epoch, 0);
+    }
+}
+
+// Caller holds retire_lock.
+static void CList_reclaim_locked(CList * list)
+{
+    unsigned long oldest = atomic_load(&list->epoch);
+    CListReader *reader = atomic_load(&list->readers);
+
+    for (; reader != NULL; reader = reader->next) {
+        unsigned long epoch = atomic_load(&reader->epoch);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    // a node retired before the oldest open section began can't be
+    // reached by anyone any more
+    CListNode **link = &list->retired;
+    while (*link) {
+        CListNode *node = *link;
+        if (node->retired_epoch < oldest) {
+            *link = node->retired_next;
+            free(node);
+            list->retired_count--;
+        } else {
+            link = &node->retired_next;
+        }
+    }
+}
+
+void CList_reclaim(CList * list)
+{
+    pthread_mutex_lock(&list->retire_lock);
+    CList_reclaim_locked(list);
+    pthread_mutex_unlock(&list->retire_lock);
+}
+
+static inline void CList_retire(CList * list, CListNode * node)
+{
+    node->retired_epoch = atomic_fetch_add(&list->epoch, 1);
+
+    pthread_mutex_lock(&list->retire_lock);
+    node->retired_next = list->retired;
+    list->retired = node;
+    list->retired_count++;
+
+    if (list->retired_count >= CLIST_RECLAIM_BATCH) {
+        CList_reclaim_locked(list);
+    }
+    pthread_mutex_unlock(&list->retire_lock);
+}
+
+int CList_push(CList * list, void *value)
+{
+    CListNode *node = malloc(sizeof(CListNode));
+    check_mem(node);
+    CListNode_init(node, value);
+
+    check(CList_read_lock(list) == 0, "Failed to enter read section.");
+
+    CListNode *last = NULL;
+    while (1) {
+        last = atomic_load(&list->tail.prev);
+        CListNode_lock(last);
+        if (atomic_load(&last->next) == &list->tail
+                && !atomic_load(&last->removed)) {
+            break;
+        }
+        CListNode_unlock(last);
+    }
+    CListNode_lock(&list->tail);
+
+    atomic_store(&node->prev, last);
+    atomic_store(&node->next, &list->tail);
+    atomic_store(&last->next, node);
+    atomic_store(&list->tail.prev, node);
+
+    CListNode_unlock(&list->tail);
+    CListNode_unlock(last);
+    CList_read_unlock(list);
+
+    atomic_fetch_add(&list->count, 1);
+
+    return 0;
+
+error:
+    free(node);
+    return -1;
+}
+
+int CList_unshift(CList * list, void *value)
+{
+    CListNode *node = malloc(sizeof(CListNode));
+    check_mem(node);
+    CListNode_init(node, value);
+
+    check(CList_read_lock(list) == 0, "Failed to enter read section.");
+
+    // under head's lock head.next can't change or go away
+    CListNode_lock(&list->head);
+    CListNode *first = atomic_load(&list->head.next);
+    CListNode_lock(first);
+
+    atomic_store(&node->prev, &list->head);
+    atomic_store(&node->next, first);
+    atomic_store(&first->prev, node);
+    atomic_store(&list->head.next, node);
+
+    CListNode_unlock(first);
+    CListNode_unlock(&list->head);
+    CList_read_unlock(list);
+
+    atomic_fetch_add(&list->count, 1);
+
+    return 0;
+
+error:
+    free(node);
+    return -1;
+}
+
+// Caller is in a read section. Returns 0 with the value in *value if
+// this thread unlinked node, -1 if it was already removed.
+static int CList_unlink(CList * list, CListNode * node, void **value)
+{
+    CListNode *prev = NULL;
+
+    while (1) {
+        if (atomic_load(&node->removed)) {
+            return -1;
+        }
+
+        prev = atomic_load(&node->prev);
+        CListNode_lock(prev);
+        CListNode_lock(node);
+
+        // node's prev only changes under node's lock
+        if (!atomic_load(&node->removed) && atomic_load(&node->prev) == prev) {
+            break;
+        }
+
+        CListNode_unlock(node);
+        CListNode_unlock(prev);
+    }
+
+    CListNode *next = atomic_load(&node->next);
+    CListNode_lock(next);
+
+    // node keeps its next so readers standing on it can move on
+    atomic_store(&prev->next, next);
+    atomic_store(&next->prev, prev);
+    atomic_store(&node->removed, 1);
+    *value = node->value;
+
+    CListNode_unlock(next);
+    CListNode_unlock(node);
+    CListNode_unlock(prev);
+
+    atomic_fetch_sub(&list->count, 1);
+    CList_retire(list, node);
+
+    return 0;
+}
+
+void *CList_remove(CList * list, CListNode * node)
+{
+    void *value = NULL;
+
+    check(list, "List is NULL");
+    check(node && node != &list->head && node != &list->tail,
+            "Invalid node.");
+    check(CList_read_lock(list) == 0, "Failed to enter read section.");
+
+    CList_unlink(list, node, &value);
+    CList_read_unlock(list);
+
+error:
+    return value;
+}
+
+void *CList_pop(CList * list)
+{
+    void *value = NULL;
+
+    check(CList_read_lock(list) == 0, "Failed to enter read section.");
+
+    while (1) {
+        CListNode *last = atomic_load(&list->tail.prev);
+        if (last == &list->head
+                || CList_unlink(list, last, &value) == 0) {
+            break;
+        }
+    }
+
+    CList_read_unlock(list);
+
+error:
+    return value;
+}
+
+void *CList_shift(CList * list)
+{
+    void *value = NULL;
+
+    check(CList_read_lock(list) == 0, "Failed to enter read section.");
+
+    while (1) {
+        CListNode *first = atomic_load(&list->head.next);
+        if (first == &list->tail
+                || CList_unlink(list, first, &value) == 0) {
+            break;
+        }
+    }
+
+    CList_read_unlock(list);
+
+error:
+    return value;
+}
@@ -0,0 +1,84 @@
+#ifndef lcthw_CList_h
+#define lcthw_CList_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Retired nodes collected before a writer tries to free them.
+#define CLIST_RECLAIM_BATCH 64
+
+typedef struct CListNode {
+    _Atomic(struct CListNode *) next;
+    _Atomic(struct CListNode *) prev;
+    void *value;
+    atomic_int removed;
+    atomic_flag lock;
+    // epoch the node was unlinked in, and the next retired node
+    unsigned long retired_epoch;
+    struct CListNode *retired_next;
+} CListNode;
+
+// Per thread read-side state, found through a ThreadSlot keyed by the
+// list.
+// epoch is 0 while the thread is outside a read section.
+typedef struct CListReader {
+    struct CListReader *next;
+    atomic_int active;
+    atomic_ulong epoch;
+    int nesting;
+} CListReader;
+
+// Doubly linked list for many readers and a few writers.
+//
+// Readers walk with CLIST_FOREACH inside CList_read_lock/unlock and
+// take no locks; they only publish the epoch they started in. Writers
+// lock just the nodes around the change, always left to right, so
+// pushes, shifts and removes on different parts of the list run at
+// once. Removed nodes keep their next link and are freed only after
+// every reader that could still see them has left its read section.
+typedef struct CList {
+    CListNode head;
+    CListNode tail;
+    atomic_int count;
+    atomic_ulong epoch;
+    _Atomic(CListReader *) readers;
+    pthread_mutex_t retire_lock;
+    CListNode *retired;
+    int retired_count;
+} CList;
+
+CList *CList_create();
+
+// Frees the nodes but not the values. No other thread may be using
+// the list.
+void CList_destroy(CList * list);
+
+#define CList_count(A) atomic_load(&(A)->count)
+
+int CList_push(CList * list, void *value);
+int CList_unshift(CList * list, void *value);
+void *CList_pop(CList * list);
+void *CList_shift(CList * list);
+
+// Unlinks node and returns its value, or NULL if another thread got
+// to it first. Find the node and remove it inside one read section so
+// it can't be freed in between.
+void *CList_remove(CList * list, CListNode * node);
+
+// Read sections nest, and writes inside one are fine: reclamation never
+// waits, it just skips nodes an open section may still reach.
+int CList_read_lock(CList * list);
+void CList_read_unlock(CList * list);
+
+// Frees retired nodes no reader can still reach. Writers call this as
+// nodes pile up; it can also be called directly.
+void CList_reclaim(CList * list);
+
+// Nodes removed during the walk may still be visited, with their old
+// values; check node->removed if that matters.
+#define CLIST_FOREACH(L, V) CListNode *V = NULL;\
+for(V = atomic_load(&(L)->head.next); V != &(L)->tail;\
+        V = atomic_load(&V->next))
+
+#endif
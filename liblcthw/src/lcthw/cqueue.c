@@ -0,0 +1,301 @@
+#include <lcthw/cqueue.h>
+#include <lcthw/thread_slot.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+
+// Called when a thread that used the queue exits.
+static void CQueueRecord_release(void *data)
+{
+    CQueueRecord *record = data;
+    int i = 0;
+
+    for (i = 0; i < CQUEUE_HAZARDS; i++) {
+        atomic_store(&record->hazards[i], NULL);
+    }
+    atomic_store(&record->active, 0);
+}
+
+CQueue *CQueue_create()
+{
+    CQueue *queue = NULL;
+    CQueueNode *dummy = NULL;
+
+    check(posix_memalign((void **)&queue, CQUEUE_CACHE_LINE,
+                sizeof(CQueue)) == 0, "Out of memory.");
+    memset(queue, 0, sizeof(CQueue));
+
+    dummy = calloc(1, sizeof(CQueueNode));
+    check_mem(dummy);
+
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    atomic_init(&queue->count, 0);
+    atomic_init(&queue->records, NULL);
+    atomic_init(&queue->record_count, 0);
+
+    return queue;
+
+error:
+    free(dummy);
+    free(queue);
+    return NULL;
+}
+
+void CQueue_destroy(CQueue * queue)
+{
+    check(queue, "queue can't be NULL");
+
+    ThreadSlot_drop(queue);
+
+    CQueueRecord *record = atomic_load(&queue->records);
+    while (record) {
+        CQueueRecord *next = record->next;
+        int i = 0;
+        for (i = 0; i < record->retired_count; i++) {
+            free(record->retired[i]);
+        }
+        free(record->retired);
+        free(record);
+        record = next;
+    }
+
+    CQueueNode *node = atomic_load(&queue->head);
+    while (node) {
+        CQueueNode *next = atomic_load(&node->next);
+        free(node);
+        node = next;
+    }
+
+    free(queue);
+
+error:
+    return;
+}
+
+// Finds this thread's record, taking over an idle one or adding a new
+// one the first time the thread touches the queue.
+static inline CQueueRecord *CQueue_record(CQueue * queue)
+{
+    CQueueRecord *record = ThreadSlot_get(queue);
+    if (record) {
+        return record;
+    }
+
+    for (record = atomic_load(&queue->records); record != NULL;
+            record = record->next) {
+        int idle = 0;
+        if (atomic_load(&record->active) == 0
+                && atomic_compare_exchange_strong(&record->active, &idle, 1)) {
+            break;
+        }
+    }
+
+    if (record == NULL) {
+        record = calloc(1, sizeof(CQueueRecord));
+        check_mem(record);
+        atomic_init(&record->active, 1);
+
+        CQueueRecord *first = atomic_load(&queue->records);
+        do {
+            record->next = first;
+        } while (!atomic_compare_exchange_weak(&queue->records, &first,
+                    record));
+        atomic_fetch_add(&queue->record_count, 1);
+    }
+
+    check(ThreadSlot_set(queue, record, CQueueRecord_release) == 0,
+            "Failed to set thread record.");
+
+    return record;
+
+error:
+    if (record) {
+        atomic_store(&record->active, 0);
+    }
+    return NULL;
+}
+
+static int CQueue_compare_ptr(const void *a, const void *b)
+{
+    uintptr_t x = (uintptr_t)*(void **)a;
+    uintptr_t y = (uintptr_t)*(void **)b;
+    return x < y ? -1 : x > y;
+}
+
+// Frees every retired node that no thread has a hazard pointer on.
+static void CQueue_scan(CQueue * queue, CQueueRecord * record)
+{
+    int max = (atomic_load(&queue->record_count) + 1) * CQUEUE_HAZARDS;
+    void **hazards = malloc(max * sizeof(void *));
+    int count = 0;
+    int kept = 0;
+    int i = 0;
+
+    // without memory to scan with, keep everything for the next try
+    if (hazards == NULL) {
+        return;
+    }
+
+    CQueueRecord *other = atomic_load(&queue->records);
+    for (; other != NULL; other = other->next) {
+        if (count + CQUEUE_HAZARDS > max) {
+            // records added since record_count was read
+            void **more = realloc(hazards, max * 2 * sizeof(void *));
+            if (more == NULL) {
+                free(hazards);
+                return;
+            }
+            hazards = more;
+            max *= 2;
+        }
+
+        for (i = 0; i < CQUEUE_HAZARDS; i++) {
+            void *hazard = atomic_load(&other->hazards[i]);
+            if (hazard) {
+                hazards[count++] = hazard;
+            }
+        }
+    }
+
+    qsort(hazards, count, sizeof(void *), CQueue_compare_ptr);
+
+    for (i = 0; i < record->retired_count; i++) {
+        CQueueNode *node = record->retired[i];
+        if (bsearch(&node, hazards, count, sizeof(void *),
+                    CQueue_compare_ptr)) {
+            record->retired[kept++] = node;
+        } else {
+            free(node);
+        }
+    }
+    record->retired_count = kept;
+
+    free(hazards);
+}
+
+static inline void CQueue_retire(CQueue * queue, CQueueRecord * record,
+        CQueueNode * node)
+{
+    if (record->retired_count == record->retired_max) {
+        int max = record->retired_max ? record->retired_max * 2
+            : CQUEUE_RETIRE_MIN;
+        CQueueNode **retired = realloc(record->retired,
+                max * sizeof(CQueueNode *));
+
+        if (retired == NULL) {
+            // leak rather than free a node someone may still be reading
+            log_err("Out of memory retiring a queue node.");
+            return;
+        }
+        record->retired = retired;
+        record->retired_max = max;
+    }
+
+    record->retired[record->retired_count++] = node;
+
+    // scan once there are clearly more retired nodes than hazards, so
+    // each scan frees a batch and the cost amortizes to O(1)
+    int threshold = 2 * CQUEUE_HAZARDS * atomic_load(&queue->record_count);
+    if (record->retired_count >= CQUEUE_RETIRE_MIN
+            && record->retired_count >= threshold) {
+        CQueue_scan(queue, record);
+    }
+}
+
+int CQueue_push(CQueue * queue, void *value)
+{
+    CQueueRecord *record = CQueue_record(queue);
+    check(record, "Failed to get a hazard record.");
+
+    CQueueNode *node = malloc(sizeof(CQueueNode));
+    check_mem(node);
+
+    node->value = value;
+    atomic_init(&node->next, NULL);
+
+    while (1) {
+        CQueueNode *tail = atomic_load(&queue->tail);
+        atomic_store(&record->hazards[0], tail);
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+
+        CQueueNode *next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+
+        if (next != NULL) {
+            // another producer linked a node but hasn't swung tail yet
+            atomic_compare_exchange_strong(&queue->tail, &tail, next);
+            continue;
+        }
+
+        CQueueNode *expected = NULL;
+        if (atomic_compare_exchange_strong(&tail->next, &expected, node)) {
+            atomic_compare_exchange_strong(&queue->tail, &tail, node);
+            break;
+        }
+    }
+
+    atomic_store(&record->hazards[0], NULL);
+    atomic_fetch_add(&queue->count, 1);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+void *CQueue_shift(CQueue * queue)
+{
+    CQueueRecord *record = CQueue_record(queue);
+    check(record, "Failed to get a hazard record.");
+
+    CQueueNode *head = NULL;
+    void *value = NULL;
+
+    while (1) {
+        head = atomic_load(&queue->head);
+        atomic_store(&record->hazards[0], head);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+
+        CQueueNode *tail = atomic_load(&queue->tail);
+        CQueueNode *next = atomic_load(&head->next);
+        atomic_store(&record->hazards[1], next);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+
+        if (next == NULL) {
+            atomic_store(&record->hazards[0], NULL);
+            atomic_store(&record->hazards[1], NULL);
+            return NULL;
+        }
+
+        if (head == tail) {
+            // tail lags behind a pushed node, help it along
+            atomic_compare_exchange_strong(&queue->tail, &tail, next);
+            continue;
+        }
+
+        // next becomes the new dummy, so read its value before the CAS
+        value = next->value;
+        if (atomic_compare_exchange_strong(&queue->head, &head, next)) {
+            break;
+        }
+    }
+
+    atomic_store(&record->hazards[0], NULL);
+    atomic_store(&record->hazards[1], NULL);
+    atomic_fetch_sub(&queue->count, 1);
+
+    CQueue_retire(queue, record, head);
+
+    return value;
+
+error:
+    return NULL;
+}
@@ -0,0 +1,61 @@
+#ifndef lcthw_CQueue_h
+#define lcthw_CQueue_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Hazard pointers each thread needs for a shift: the head and its next.
+#define CQUEUE_HAZARDS 2
+
+// Retired nodes a thread collects before it scans the hazard pointers.
+#define CQUEUE_RETIRE_MIN 64
+
+#define CQUEUE_CACHE_LINE 64
+
+typedef struct CQueueNode {
+    _Atomic(struct CQueueNode *) next;
+    void *value;
+} CQueueNode;
+
+// Per thread hazard pointers and retired nodes, found through a
+// ThreadSlot keyed by the queue. Records are never unlinked; a thread
+// that exits leaves its record (and any nodes it still has retired)
+// for the next thread to pick up.
+typedef struct CQueueRecord {
+    struct CQueueRecord *next;
+    atomic_int active;
+    _Atomic(CQueueNode *) hazards[CQUEUE_HAZARDS];
+    CQueueNode **retired;
+    int retired_count;
+    int retired_max;
+} CQueueRecord;
+
+// Lock-free multi producer, multi consumer FIFO (Michael & Scott) with
+// hazard pointer reclamation. head always points at a dummy node; the
+// values live in the nodes after it. head and tail sit on their own
+// cache lines so producers and consumers don't false share.
+typedef struct CQueue {
+    _Alignas(CQUEUE_CACHE_LINE) _Atomic(CQueueNode *) head;
+    _Alignas(CQUEUE_CACHE_LINE) _Atomic(CQueueNode *) tail;
+    _Alignas(CQUEUE_CACHE_LINE) atomic_int count;
+    _Atomic(CQueueRecord *) records;
+    atomic_int record_count;
+} CQueue;
+
+CQueue *CQueue_create();
+
+// Frees the queue and its nodes but not the values. No other thread
+// may be using the queue.
+void CQueue_destroy(CQueue * queue);
+
+// Safe to call from any number of threads at once. CQueue_shift
+// returns NULL when the queue is empty, so like List_shift it can't
+// tell an empty queue from a NULL value.
+int CQueue_push(CQueue * queue, void *value);
+void *CQueue_shift(CQueue * queue);
+
+// A snapshot; it may already be stale when other threads are active.
+#define CQueue_count(A) atomic_load(&(A)->count)
+
+#endif
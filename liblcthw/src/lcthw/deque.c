@@ -0,0 +1,155 @@
+#include <lcthw/deque.h>
+#include <lcthw/dbg.h>
+
+Deque *Deque_create()
+{
+    Deque *deque = calloc(1, sizeof(Deque));
+    check_mem(deque);
+
+    deque->capacity = DEQUE_MIN_CAPACITY;
+    deque->values = malloc(deque->capacity * sizeof(void *));
+    check_mem(deque->values);
+
+    return deque;
+
+error:
+    free(deque);
+    return NULL;
+}
+
+void Deque_clear(Deque * deque)
+{
+    int i = 0;
+
+    check(deque, "deque can't be NULL");
+
+    for (i = 0; i < deque->count; i++) {
+        free(Deque_get(deque, i));
+    }
+
+error:
+    return;
+}
+
+void Deque_destroy(Deque * deque)
+{
+    if (deque) {
+        free(deque->values);
+        free(deque);
+    }
+}
+
+void Deque_clear_destroy(Deque * deque)
+{
+    Deque_clear(deque);
+    Deque_destroy(deque);
+}
+
+// Moves the values into a new buffer of capacity slots, unwrapped so
+// the first value lands at 0.
+static int Deque_resize(Deque * deque, int capacity)
+{
+    void **values = malloc(capacity * sizeof(void *));
+    check_mem(values);
+
+    int first_part = deque->capacity - deque->head;
+    if (first_part > deque->count) {
+        first_part = deque->count;
+    }
+
+    memcpy(values, deque->values + deque->head,
+            first_part * sizeof(void *));
+    memcpy(values + first_part, deque->values,
+            (deque->count - first_part) * sizeof(void *));
+
+    free(deque->values);
+    deque->values = values;
+    deque->capacity = capacity;
+    deque->head = 0;
+
+    return 0;
+
+error:
+    return -1;
+}
+
+static inline int Deque_grow(Deque * deque)
+{
+    if (deque->count < deque->capacity) {
+        return 0;
+    }
+
+    return Deque_resize(deque, deque->capacity * 2);
+}
+
+// A failed shrink just leaves the buffer bigger than it needs to be.
+static inline void Deque_shrink(Deque * deque)
+{
+    if (deque->capacity > DEQUE_MIN_CAPACITY
+            && deque->count < deque->capacity / DEQUE_SHRINK_DIVISOR) {
+        Deque_resize(deque, deque->capacity / 2);
+    }
+}
+
+void Deque_push(Deque * deque, void *value)
+{
+    check(deque, "deque can't be NULL");
+    check(Deque_grow(deque) == 0, "Failed to grow deque.");
+
+    int tail = (deque->head + deque->count) & (deque->capacity - 1);
+    deque->values[tail] = value;
+    deque->count++;
+
+error:
+    return;
+}
+
+void *Deque_pop(Deque * deque)
+{
+    void *value = NULL;
+
+    check(deque, "deque can't be NULL");
+
+    if (deque->count == 0) {
+        return NULL;
+    }
+
+    deque->count--;
+    value = Deque_get(deque, deque->count);
+    Deque_shrink(deque);
+
+error:
+    return value;
+}
+
+void Deque_unshift(Deque * deque, void *value)
+{
+    check(deque, "deque can't be NULL");
+    check(Deque_grow(deque) == 0, "Failed to grow deque.");
+
+    deque->head = (deque->head - 1) & (deque->capacity - 1);
+    deque->values[deque->head] = value;
+    deque->count++;
+
+error:
+    return;
+}
+
+void *Deque_shift(Deque * deque)
+{
+    void *value = NULL;
+
+    check(deque, "deque can't be NULL");
+
+    if (deque->count == 0) {
+        return NULL;
+    }
+
+    value = deque->values[deque->head];
+    deque->head = (deque->head + 1) & (deque->capacity - 1);
+    deque->count--;
+    Deque_shrink(deque);
+
+error:
+    return value;
+}
@@ -0,0 +1,46 @@
+#ifndef lcthw_Deque_h
+#define lcthw_Deque_h
+
+#include <stdlib.h>
+
+#define DEQUE_MIN_CAPACITY 16
+
+// The buffer halves once fewer than capacity / DEQUE_SHRINK_DIVISOR
+// slots are used, leaving it one slot short of half full. Growing
+// doubles a full buffer, leaving it exactly half full. Either way it
+// takes about a quarter of the new capacity in pops, or half of it in
+// pushes, before the next resize.
+#define DEQUE_SHRINK_DIVISOR 4
+
+// Growable ring buffer with the List push/pop/shift/unshift surface.
+// The values sit contiguously in values[head .. head + count), wrapping
+// at capacity, which is always a power of two.
+typedef struct Deque {
+    int count;
+    int capacity;
+    int head;
+    void **values;
+} Deque;
+
+Deque *Deque_create();
+void Deque_clear(Deque * deque);
+void Deque_destroy(Deque * deque);
+void Deque_clear_destroy(Deque * deque);
+
+#define Deque_count(A) ((A)->count)
+#define Deque_first(A) ((A)->count > 0 ? Deque_get((A), 0) : NULL)
+#define Deque_last(A) ((A)->count > 0 ? Deque_get((A), (A)->count - 1) : NULL)
+
+void Deque_push(Deque * deque, void *value);
+void *Deque_pop(Deque * deque);
+
+void Deque_unshift(Deque * deque, void *value);
+void *Deque_shift(Deque * deque);
+
+// i counts from the first value; no bounds check.
+static inline void *Deque_get(Deque * deque, int i)
+{
+    return deque->values[(deque->head + i) & (deque->capacity - 1)];
+}
+
+#endif
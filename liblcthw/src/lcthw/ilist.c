@@ -0,0 +1,161 @@
+#include <lcthw/ilist.h>
+#include <lcthw/dbg.h>
+
+IList *IList_create()
+{
+    return calloc(1, sizeof(IList));
+}
+
+void IList_destroy(IList * list)
+{
+    // the links belong to the records, so only the head is freed
+    free(list);
+}
+
+void IList_push(IList * list, IListLink * link)
+{
+    check(list, "IList is NULL");
+    check(link, "link can't be NULL");
+
+    link->next = NULL;
+    link->prev = list->last;
+
+    if (list->last == NULL) {
+        list->first = link;
+    } else {
+        list->last->next = link;
+    }
+    list->last = link;
+
+    list->count++;
+
+error:
+    return;
+}
+
+IListLink *IList_pop(IList * list)
+{
+    IListLink *link = list->last;
+    return link != NULL ? IList_remove(list, link) : NULL;
+}
+
+void IList_unshift(IList * list, IListLink * link)
+{
+    check(list, "IList is NULL");
+    check(link, "link can't be NULL");
+
+    link->prev = NULL;
+    link->next = list->first;
+
+    if (list->first == NULL) {
+        list->last = link;
+    } else {
+        list->first->prev = link;
+    }
+    list->first = link;
+
+    list->count++;
+
+error:
+    return;
+}
+
+IListLink *IList_shift(IList * list)
+{
+    IListLink *link = list->first;
+    return link != NULL ? IList_remove(list, link) : NULL;
+}
+
+void IList_join(IList * list1, IList * list2)
+{
+    check(list1, "List1 is NULL");
+    check(list2, "List2 is NULL");
+
+    if (list2->first == NULL) {
+        return;
+    }
+
+    if (list1->last == NULL) {
+        list1->first = list2->first;
+    } else {
+        list1->last->next = list2->first;
+        list2->first->prev = list1->last;
+    }
+
+    list1->last = list2->last;
+    list1->count += list2->count;
+
+    list2->first = NULL;
+    list2->last = NULL;
+    list2->count = 0;
+
+error:
+    return;
+}
+
+IList *IList_split(IList * list, int index)
+{
+    IList *new_list = NULL;
+
+    check(list != NULL, "IList is NULL.");
+    check(index >= 0 && index <= list->count, "Index out of bounds.");
+
+    new_list = IList_create();
+    check_mem(new_list);
+
+    if (index == list->count) {
+        return new_list;
+    }
+
+    IListLink *current = list->first;
+    int i = 0;
+    for (i = 0; i < index; i++) {
+        current = current->next;
+    }
+
+    new_list->first = current;
+    new_list->last = list->last;
+    new_list->count = list->count - index;
+
+    list->last = current->prev;
+    if (list->last) {
+        list->last->next = NULL;
+    } else {
+        list->first = NULL;
+    }
+    list->count = index;
+
+    current->prev = NULL;
+
+    return new_list;
+
+error:
+    return NULL;
+}
+
+IListLink *IList_remove(IList * list, IListLink * link)
+{
+    check(list->first && list->last, "IList is empty.");
+    check(link, "link can't be NULL");
+
+    if (link->prev) {
+        link->prev->next = link->next;
+    } else {
+        list->first = link->next;
+    }
+
+    if (link->next) {
+        link->next->prev = link->prev;
+    } else {
+        list->last = link->prev;
+    }
+
+    link->next = NULL;
+    link->prev = NULL;
+    list->count--;
+
+    return link;
+
+error:
+    return NULL;
+}
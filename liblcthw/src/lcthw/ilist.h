@@ -0,0 +1,52 @@
+#ifndef lcthw_IList_h
+#define lcthw_IList_h
+
+#include <stdlib.h>
+#include <stddef.h>
+
+// Intrusive list: the link lives inside the user's record, so push,
+// remove and iterate allocate nothing and never chase a value pointer.
+// Embed an IListLink in the record and get back to the record with
+// IList_entry. A link can only be on one IList at a time.
+typedef struct IListLink {
+    struct IListLink *next;
+    struct IListLink *prev;
+} IListLink;
+
+typedef struct IList {
+    int count;
+    IListLink *first;
+    IListLink *last;
+} IList;
+
+#define IList_entry(P, T, M) ((T *)((char *)(P) - offsetof(T, M)))
+
+IList *IList_create();
+void IList_destroy(IList * list);
+
+#define IList_count(A) ((A)->count)
+#define IList_first(A, T, M) ((A)->first != NULL ?\
+        IList_entry((A)->first, T, M) : NULL)
+#define IList_last(A, T, M) ((A)->last != NULL ?\
+        IList_entry((A)->last, T, M) : NULL)
+
+void IList_push(IList * list, IListLink * link);
+IListLink *IList_pop(IList * list);
+
+void IList_unshift(IList * list, IListLink * link);
+IListLink *IList_shift(IList * list);
+
+// list2 is left empty.
+void IList_join(IList * list1, IList * list2);
+IList *IList_split(IList * list, int index);
+
+IListLink *IList_remove(IList * list, IListLink * link);
+
+// Walks list L from S (first/last) along M (next/prev), binding V to
+// the T record that holds each link in its member F.
+#define ILIST_FOREACH(L, S, M, T, F, V) IListLink *_ilink = NULL;\
+                                        T *V = NULL;\
+for(_ilink = (L)->S; _ilink != NULL && ((V = IList_entry(_ilink, T, F)), 1);\
+        _ilink = _ilink->M)
+
+#endif
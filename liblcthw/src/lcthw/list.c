@@ -1,50 +1,149 @@
 #include <lcthw/list.h>
+#include <lcthw/list_pool.h>
+#include <lcthw/list_index.h>
 #include <lcthw/dbg.h>
+#include <stddef.h>
 
 List *List_create()
 {
     return calloc(1, sizeof(List));
 }
 
-// void List_clear(List * list)
-// {
-//     LIST_FOREACH(list, first, next, cur) {
-//         free(cur->value);
-//     }
-// }
+List *List_create_pooled(ListPool * pool)
+{
+    List *list = calloc(1, sizeof(List));
+    check_mem(list);
 
-// void List_destroy(List * list)
-// {
-//     LIST_FOREACH(list, first, next, cur) {
-//         if (cur->prev) {
-//             free(cur->prev);
-//         }
-//     }
+    if (pool) {
+        ListPool_retain(pool);
+        list->pool = pool;
+    } else {
+        list->pool = ListPool_create(LIST_POOL_DEFAULT_SLAB);
+        check_mem(list->pool);
+    }
 
-//     free(list->last);
-//     free(list);
-// }
+    return list;
 
-// void List_clear_destroy(List * list)
-// {
-//     List_clear(list);
-//     List_destroy(list);
-// }
+error:
+    free(list);
+    return NULL;
+}
 
-void List_clear_destroy(List * list)
+List *List_create_inline(size_t element_size)
+{
+    check(element_size > 0, "element_size must be > 0.");
+
+    List *list = calloc(1, sizeof(List));
+    check_mem(list);
+
+    list->element_size = element_size;
+
+    return list;
+
+error:
+    return NULL;
+}
+
+// Inline values start after the links, rounded up so that calloc's
+// alignment carries over to them.
+#define LIST_INLINE_OFFSET ((sizeof(ListNode) + _Alignof(max_align_t) - 1) \
+        & ~(_Alignof(max_align_t) - 1))
+
+static inline ListNode *ListNode_alloc(List * list)
+{
+    if (list->pool) {
+        return ListPool_alloc(list->pool);
+    }
+
+    ListNode *node = NULL;
+    if (list->element_size) {
+        node = calloc(1, LIST_INLINE_OFFSET + list->element_size);
+        if (node) {
+            node->value = (char *)node + LIST_INLINE_OFFSET;
+        }
+    } else {
+        node = calloc(1, sizeof(ListNode));
+    }
+
+    return node;
+}
+
+// Inline lists copy the element into the node, others keep the pointer.
+static inline void ListNode_set(List * list, ListNode * node, void *value)
+{
+    if (list->element_size == 0) {
+        node->value = value;
+    } else if (value) {
+        memcpy(node->value, value, list->element_size);
+    }
+}
+
+static inline void ListNode_free(List * list, ListNode * node)
+{
+    if (list->pool) {
+        ListPool_free(list->pool, node);
+    } else {
+        free(node);
+    }
+}
+
+void List_clear(List * list)
 {
     check(list, "List is NULL");
 
+    // inline values go away with their nodes
+    if (list->element_size) {
+        return;
+    }
+
+    LIST_FOREACH(list, first, next, cur) {
+        free(cur->value);
+    }
+
+error:
+    return;
+}
+
+void List_destroy(List * list)
+{
+    check(list, "List is NULL");
+
+    List_unindex(list);
+
+    // the last list using a pool frees its slabs wholesale,
+    // otherwise the nodes go back to the shared pool
+    if (list->pool && list->pool->refcount == 1) {
+        ListPool_release(list->pool);
+        free(list);
+        return;
+    }
+
     LIST_FOREACH(list, first, next, cur) {
         if (cur->prev) {
-            free(cur->prev);
-            free(cur->value);
+            ListNode_free(list, cur->prev);
         }
     }
 
-    free(list->last);
+    if (list->last) {
+        ListNode_free(list, list->last);
+    }
+
+    if (list->pool) {
+        ListPool_release(list->pool);
+    }
+
     free(list);
-    check_mem(list);
+
+error:
+    return;
+}
+
+void List_clear_destroy(List * list)
+{
+    check(list, "List is NULL");
+
+    List_clear(list);
+    List_destroy(list);
 
 error:
     return;
@@ -56,10 +155,10 @@ void List_push(List * list, void *value)
 
     int old_count = list->count;  // Capture count before modification
 
-    ListNode *node = calloc(1, sizeof(ListNode));
+    ListNode *node = ListNode_alloc(list);
     check_mem(node);
 
-    node->value = value;
+    ListNode_set(list, node, value);
 
     if (list->last == NULL) {
         list->first = node;
@@ -72,6 +171,10 @@ void List_push(List * list, void *value)
 
     list->count++;
 
+    if (list->index) {
+        ListIndex_added(list, node, list->count - 1);
+    }
+
     check(list->count == old_count + 1, "Count did not increase by one.");
     check(((list->count == 0 && list->first == NULL && list->last == NULL) ||
            (list->count > 0 && list->first != NULL && list->last != NULL)), "List is in an invalid state.");
@@ -88,10 +191,10 @@ void *List_pop(List * list)
 
 void List_unshift(List * list, void *value)
 {
-    ListNode *node = calloc(1, sizeof(ListNode));
+    ListNode *node = ListNode_alloc(list);
     check_mem(node);
 
-    node->value = value;
+    ListNode_set(list, node, value);
 
     if (list->first == NULL) {
         list->first = node;
@@ -104,6 +207,10 @@ void List_unshift(List * list, void *value)
 
     list->count++;
 
+    if (list->index) {
+        ListIndex_added(list, node, 0);
+    }
+
 error:
     return;
 }
@@ -114,6 +221,333 @@ void *List_shift(List * list)
     return node != NULL ? List_remove(list, node) : NULL;
 }
 
+void *List_push_new(List * list)
+{
+    check(list && list->element_size > 0,
+            "List_push_new needs an inline list.");
+
+    int old_count = list->count;
+    List_push(list, NULL);
+    check(list->count == old_count + 1, "Failed to push a new element.");
+
+    return list->last->value;
+
+error:
+    return NULL;
+}
+
+void *List_unshift_new(List * list)
+{
+    check(list && list->element_size > 0,
+            "List_unshift_new needs an inline list.");
+
+    int old_count = list->count;
+    List_unshift(list, NULL);
+    check(list->count == old_count + 1, "Failed to unshift a new element.");
+
+    return list->first->value;
+
+error:
+    return NULL;
+}
+
+static inline int List_remove_into(List * list, ListNode * node, void *out)
+{
+    check(list->element_size > 0, "Only inline lists can copy values out.");
+    check(node, "List is empty.");
+
+    if (out) {
+        memcpy(out, node->value, list->element_size);
+    }
+    List_remove(list, node);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int List_pop_into(List * list, void *out)
+{
+    return List_remove_into(list, list->last, out);
+}
+
+int List_shift_into(List * list, void *out)
+{
+    return List_remove_into(list, list->first, out);
+}
+
+List *List_from_array(void **values, int n)
+{
+    List *list = List_create_pooled(NULL);
+    check_mem(list);
+
+    check(List_push_many(list, values, n) == 0,
+            "Failed to build list from array.");
+
+    return list;
+
+error:
+    if (list) {
+        List_destroy(list);
+    }
+    return NULL;
+}
+
+// Builds a detached chain of n nodes, *first to the returned last.
+static inline ListNode *List_build_chain(List * list, void **values,
+        int n, ListNode ** first)
+{
+    ListNode *prev = NULL;
+    int i = 0;
+
+    if (list->pool) {
+        ListNode *node = ListPool_alloc_many(list->pool, n);
+        check_mem(node);
+
+        // the nodes come chained through next, so only prev needs setting
+        *first = node;
+        for (i = 0; i < n; i++, node = node->next) {
+            node->prev = prev;
+            node->value = values[i];
+            prev = node;
+        }
+
+        return prev;
+    }
+
+    *first = NULL;
+    for (i = 0; i < n; i++) {
+        ListNode *node = ListNode_alloc(list);
+        check_mem(node);
+        ListNode_set(list, node, values[i]);
+
+        node->prev = prev;
+        if (prev) {
+            prev->next = node;
+        } else {
+            *first = node;
+        }
+        prev = node;
+    }
+
+    return prev;
+
+error:
+    // only the calloc path can fail half way
+    while (prev) {
+        ListNode *node = prev;
+        prev = prev->prev;
+        free(node);
+    }
+    return NULL;
+}
+
+int List_push_many(List * list, void **values, int n)
+{
+    ListNode *first = NULL;
+
+    check(list, "List is NULL");
+    check(n >= 0, "n must be >= 0.");
+
+    if (n == 0) {
+        return 0;
+    }
+
+    check(values, "values can't be NULL");
+
+    ListNode *last = List_build_chain(list, values, n, &first);
+    check(last, "Failed to allocate %d nodes.", n);
+
+    if (list->last == NULL) {
+        list->first = first;
+    } else {
+        list->last->next = first;
+        first->prev = list->last;
+    }
+    list->last = last;
+    list->count += n;
+
+    if (list->index) {
+        ListIndex_rebuild(list);
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int List_to_array(List * list, void **out)
+{
+    int i = 0;
+
+    check(list, "List is NULL");
+    check(out || list->count == 0, "out can't be NULL");
+
+    LIST_FOREACH(list, first, next, cur) {
+        out[i++] = cur->value;
+    }
+
+    return i;
+
+error:
+    return -1;
+}
+
+int List_compact(List * list)
+{
+    ListPool *old_pool = NULL;
+    ListPool *new_pool = NULL;
+
+    check(list, "List is NULL");
+    check(list->element_size == 0, "Inline lists can't be compacted.");
+
+    if (list->count == 0) {
+        return 0;
+    }
+
+    // The old slabs must all go once the nodes are copied, or every
+    // compaction would grow the pool by count nodes. That is only safe
+    // when they hold nothing but this list's nodes.
+    check(list->pool == NULL || (list->pool->refcount == 1
+                && list->pool->data_bytes == 0),
+            "Can't compact a list on a shared pool or one holding values.");
+
+    // Plain lists get a private pool.
+    if (list->pool == NULL) {
+        new_pool = ListPool_create(LIST_POOL_DEFAULT_SLAB);
+        check_mem(new_pool);
+    } else {
+        old_pool = list->pool;
+        new_pool = ListPool_create(old_pool->slab_size);
+        check_mem(new_pool);
+    }
+
+    ListNode *nodes = ListPool_alloc_block(new_pool, list->count);
+    check_mem(nodes);
+
+    ListNode *cur = list->first;
+    int i = 0;
+    for (i = 0; cur != NULL; i++) {
+        ListNode *next = cur->next;
+
+        nodes[i].value = cur->value;
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = &nodes[i + 1];
+
+        if (list->pool == NULL) {
+            free(cur);
+        }
+
+        cur = next;
+    }
+    nodes[i - 1].next = NULL;
+
+    list->first = &nodes[0];
+    list->last = &nodes[i - 1];
+
+    if (old_pool) {
+        // swap the fresh slab into the pool the list already points at,
+        // then drop the scattered slabs along with the spare pool
+        ListSlab *slabs = old_pool->slabs;
+        old_pool->slabs = new_pool->slabs;
+        old_pool->free_nodes = NULL;
+        old_pool->free_count = 0;
+        new_pool->slabs = slabs;
+        ListPool_release(new_pool);
+    } else if (list->pool == NULL) {
+        list->pool = new_pool;
+    }
+
+    // towers are keyed by node address
+    if (list->index) {
+        ListIndex_rebuild(list);
+    }
+
+    return 0;
+
+error:
+    if (new_pool && new_pool != list->pool) {
+        ListPool_release(new_pool);
+    }
+    return -1;
+}
+
+List *List_copy(List * list)
+{
+    return List_deep_copy(list, NULL);
+}
+
+// Copies are padded so the next one starts aligned for any type.
+static inline size_t List_copy_align(size_t size)
+{
+    size_t align = _Alignof(max_align_t);
+    return (size + align - 1) & ~(align - 1);
+}
+
+List *List_deep_copy(List * list, List_copy_fn copy)
+{
+    List *dup = NULL;
+    ListNode *cur = NULL;
+    size_t extra = 0;
+    char *data = NULL;
+    int i = 0;
+
+    check(list, "List is NULL");
+    check(list->element_size == 0, "Inline lists can't be copied.");
+
+    dup = List_create_pooled(NULL);
+    check_mem(dup);
+
+    if (list->count == 0) {
+        return dup;
+    }
+
+    // size every value first so nodes and values take one allocation
+    if (copy) {
+        for (cur = list->first; cur != NULL; cur = cur->next) {
+            extra += List_copy_align(copy(NULL, cur->value));
+        }
+    }
+
+    ListNode *nodes = ListPool_alloc_block_data(dup->pool, list->count,
+            extra, (void **)&data);
+    check_mem(nodes);
+
+    for (cur = list->first; cur != NULL; cur = cur->next, i++) {
+        if (copy && extra > 0) {
+            // ask again before writing, so a copy that changed its mind
+            // is caught before it runs off the block
+            size_t need = List_copy_align(copy(NULL, cur->value));
+            check(need <= extra, "copy needs more than it asked for.");
+            size_t used = List_copy_align(copy(data, cur->value));
+            check(used <= need, "copy used more than it asked for.");
+            nodes[i].value = data;
+            data += used;
+            extra -= used;
+        } else {
+            nodes[i].value = copy ? NULL : cur->value;
+        }
+
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = &nodes[i + 1];
+    }
+    nodes[i - 1].next = NULL;
+
+    dup->first = &nodes[0];
+    dup->last = &nodes[i - 1];
+    dup->count = i;
+
+    return dup;
+
+error:
+    if (dup) {
+        List_destroy(dup);
+    }
+    return NULL;
+}
+
 void List_print(List *list) {
     check(list->first && list->last, "List is empty.");
     ListNode *current = list->first;
@@ -131,6 +565,12 @@ void List_join(List *list1, List *list2)
 {
     check(list1, "List1 is NULL");
     check(list2, "List2 is NULL");
+    check(list1->pool == list2->pool,
+            "Can't join lists that use different node pools.");
+    check(list1->element_size == list2->element_size,
+            "Can't join lists with different inline element sizes.");
+
+    int count1 = list1->count;
     
     list1->last->next = list2->first;
     list2->first->prev = list1->last;
@@ -138,6 +578,22 @@ void List_join(List *list1, List *list2)
     list1->last = list2->last;
     list1->count += list2->count;
 
+    // halves of one split index splice back together in O(log n)
+    if (list1->index && list2->index
+            && list1->index->map == list2->index->map) {
+        ListIndex_join(list1, list2, count1);
+    } else {
+        List_unindex(list2);
+        if (list1->index) {
+            ListIndex_rebuild(list1);
+        }
+    }
+
+    // list2 keeps its pool reference but no longer owns the nodes
+    list2->first = NULL;
+    list2->last = NULL;
+    list2->count = 0;
+
 error:
     return;
 }
@@ -210,13 +666,17 @@ void *List_split(List *list, int index)
         return new_list;
     }
 
-    List *new_list = List_create();
+    // The new list keeps drawing from the same pool as its nodes
+    List *new_list = list->pool ? List_create_pooled(list->pool)
+        : List_create();
     check_mem(new_list);
+    new_list->element_size = list->element_size;
 
-    // Traverse to the node at position `index`.
-    ListNode *current = list->first;
-    for (int i = 0; i < index; i++) {
-        current = current->next;
+    ListNode *current = List_node_at(list, index);
+
+    if (list->index) {
+        new_list->index = ListIndex_split(list, index);
+        check_mem(new_list->index);
     }
 
     // `current` is the first node of the new list
@@ -241,6 +701,78 @@ error:
 }
 
 
+ListNode *List_node_at(List * list, int index)
+{
+    check(list, "List is NULL");
+    check(index >= 0 && index < list->count, "Index out of bounds.");
+
+    if (list->index) {
+        return ListIndex_node_at(list, index);
+    }
+
+    ListNode *node = NULL;
+    int i = 0;
+    if (index < list->count / 2) {
+        node = list->first;
+        for (i = 0; i < index; i++) {
+            node = node->next;
+        }
+    } else {
+        node = list->last;
+        for (i = list->count - 1; i > index; i--) {
+            node = node->prev;
+        }
+    }
+
+    return node;
+
+error:
+    return NULL;
+}
+
+void *List_get(List * list, int index)
+{
+    ListNode *node = List_node_at(list, index);
+    return node != NULL ? node->value : NULL;
+}
+
+int List_insert(List * list, int index, void *value)
+{
+    check(list, "List is NULL");
+    check(index >= 0 && index <= list->count, "Index out of bounds.");
+
+    int old_count = list->count;
+
+    if (index == list->count) {
+        List_push(list, value);
+    } else if (index == 0) {
+        List_unshift(list, value);
+    } else {
+        ListNode *after = List_node_at(list, index);
+        ListNode *node = ListNode_alloc(list);
+        check_mem(node);
+
+        ListNode_set(list, node, value);
+
+        node->next = after;
+        node->prev = after->prev;
+        after->prev->next = node;
+        after->prev = node;
+        list->count++;
+
+        if (list->index) {
+            ListIndex_added(list, node, index);
+        }
+    }
+
+    check(list->count == old_count + 1, "Failed to insert at %d.", index);
+
+    return 0;
+
+error:
+    return -1;
+}
+
 void *List_remove(List * list, ListNode * node)
 {
     void *result = NULL;
@@ -248,6 +780,10 @@ void *List_remove(List * list, ListNode * node)
     check(list->first && list->last, "List is empty.");
     check(node, "node can't be NULL");
 
+    if (list->index) {
+        ListIndex_removing(list, node);
+    }
+
     if (node == list->first && node == list->last) {
         list->first = NULL;
         list->last = NULL;
@@ -269,9 +805,44 @@ void *List_remove(List * list, ListNode * node)
     }
 
     list->count--;
-    result = node->value;
-    free(node);
+    // an inline value is freed along with its node
+    result = list->element_size ? NULL : node->value;
+    ListNode_free(list, node);
 
 error:
     return result;
-}
\ No newline at end of file
+}
+
+void List_move_first(List * list, ListNode * node)
+{
+    check(list, "List is NULL");
+    check(node, "node can't be NULL");
+
+    if (node == list->first) {
+        return;
+    }
+
+    if (list->index) {
+        ListIndex_removing(list, node);
+    }
+
+    // node isn't first, so it has a prev
+    node->prev->next = node->next;
+    if (node == list->last) {
+        list->last = node->prev;
+    } else {
+        node->next->prev = node->prev;
+    }
+
+    node->prev = NULL;
+    node->next = list->first;
+    list->first->prev = node;
+    list->first = node;
+
+    if (list->index) {
+        ListIndex_added(list, node, 0);
+    }
+
+error:
+    return;
+}
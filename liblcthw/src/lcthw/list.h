@@ -4,6 +4,8 @@
 #include <stdlib.h>
 
 struct ListNode;
+struct ListPool;
+struct ListIndex;
 
 typedef struct ListNode {
     struct ListNode *next;
@@ -15,9 +17,18 @@ typedef struct List {
     int count;
     ListNode *first;
     ListNode *last;
+    struct ListPool *pool;
+    size_t element_size;
+    struct ListIndex *index;
 } List;
     
 List *List_create();
+List *List_create_pooled(struct ListPool *pool);
+
+// Inline lists store each element_size payload in the same allocation
+// as its node, after the links and aligned for any type; node->value
+// points at it.
+List *List_create_inline(size_t element_size);
 void List_clear(List * list);
 void List_destroy(List * list);
 void List_clear_destroy(List * list);
@@ -32,15 +43,70 @@ void *List_pop(List * list);
 void List_unshift(List * list, void *value);
 void *List_shift(List * list);
 
+// Inline lists only: List_push/List_unshift copy element_size bytes
+// from value, the _new variants return zeroed in-node storage to fill
+// in. Removing an element frees its storage, so List_pop/List_shift/
+// List_remove return NULL; use the _into variants to copy it out.
+void *List_push_new(List * list);
+void *List_unshift_new(List * list);
+int List_pop_into(List * list, void *out);
+int List_shift_into(List * list, void *out);
+
+// Builds a pooled list whose n nodes sit in one contiguous block.
+List *List_from_array(void **values, int n);
+
+// Links n new nodes in one pass and splices them on the end in O(1).
+// Pooled lists take the nodes off the pool's free list in one go,
+// adding at most one slab for any shortfall, so nodes freed by earlier
+// removes are reused; plain and inline lists still allocate each node.
+// Returns 0 or -1.
+int List_push_many(List * list, void **values, int n);
+
+// Copies the List_count(list) values into out, which must have room
+// for them (e.g. DArray contents after a reserve). Returns the count.
+int List_to_array(List * list, void **out);
+
+// Moves every node into one contiguous block in traversal order and
+// fixes up the links, so a list scattered by churn iterates like an
+// array again. The block replaces every slab of the list's private
+// pool, so repeated compaction doesn't grow it; plain lists are given
+// a private pool and behave as pooled lists from then on. Fails (-1)
+// for inline lists, lists on a pool shared with other lists, and deep
+// copies (see List_deep_copy), since none of those can free their old
+// slabs. Returns 0 or -1.
+int List_compact(List * list);
+
 void List_print(List *list);
 
 void List_join(List *list1, List *list2);
 void *List_split(List *list, int index);
 
-// void List_copy(List *list1, List *list2);
+// Positional access. These walk from the nearer end in O(n), or take
+// O(log n) once the list has an index (see list_index.h).
+ListNode *List_node_at(List * list, int index);
+void *List_get(List * list, int index);
+int List_insert(List * list, int index, void *value);
+
+// Copies value into dst and returns the bytes used, or with dst NULL
+// returns the bytes it would use; both calls must agree. List_deep_copy
+// asks again right before each copy and fails if the answer grew.
+typedef size_t (*List_copy_fn) (void *dst, const void *value);
+
+// Snapshots list into a new pooled list whose nodes are one contiguous
+// block, linked in one pass. The values are shared with list.
+List *List_copy(List * list);
+
+// Like List_copy, but each value is copied with copy into the same
+// block, after the nodes. List_destroy frees the whole snapshot at
+// once; don't List_clear it, the values aren't separate allocations.
+// Inline lists can't be copied.
+List *List_deep_copy(List * list, List_copy_fn copy);
 
 void *List_remove(List * list, ListNode * node);
 
+// Relinks node at the front in O(1) without freeing or allocating it.
+void List_move_first(List * list, ListNode * node);
+
 #define LIST_FOREACH(L, S, M, V) ListNode *_node = NULL;\
                                                    ListNode *V = NULL;\
 for(V = _node = L->S; _node != NULL; V = _node = _node->M)
@@ -0,0 +1,494 @@
+#include <lcthw/list_index.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+
+#define LIST_TOWER_MAP_MIN 64
+
+static inline size_t ListTowerMap_hash(ListNode * key)
+{
+    uint64_t h = (uintptr_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h;
+}
+
+static ListTowerMap *ListTowerMap_create(int capacity)
+{
+    ListTowerMap *map = calloc(1, sizeof(ListTowerMap));
+    check_mem(map);
+
+    map->refcount = 1;
+    map->capacity = capacity;
+    map->keys = calloc(capacity, sizeof(ListNode *));
+    map->towers = calloc(capacity, sizeof(ListTower *));
+    check_mem(map->keys && map->towers);
+
+    return map;
+
+error:
+    if (map) {
+        free(map->keys);
+        free(map->towers);
+        free(map);
+    }
+    return NULL;
+}
+
+static void ListTowerMap_release(ListTowerMap * map)
+{
+    map->refcount--;
+    if (map->refcount == 0) {
+        free(map->keys);
+        free(map->towers);
+        free(map);
+    }
+}
+
+static inline int ListTowerMap_slot(ListTowerMap * map, ListNode * key)
+{
+    size_t mask = map->capacity - 1;
+    size_t i = ListTowerMap_hash(key) & mask;
+
+    while (map->keys[i] != NULL && map->keys[i] != key) {
+        i = (i + 1) & mask;
+    }
+
+    return (int)i;
+}
+
+static int ListTowerMap_put(ListTowerMap * map, ListNode * key,
+        ListTower * tower);
+
+static int ListTowerMap_grow(ListTowerMap * map)
+{
+    ListTowerMap *bigger = ListTowerMap_create(map->capacity * 2);
+    check_mem(bigger);
+
+    int i = 0;
+    for (i = 0; i < map->capacity; i++) {
+        if (map->keys[i]) {
+            ListTowerMap_put(bigger, map->keys[i], map->towers[i]);
+        }
+    }
+
+    free(map->keys);
+    free(map->towers);
+    map->keys = bigger->keys;
+    map->towers = bigger->towers;
+    map->capacity = bigger->capacity;
+    free(bigger);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+static int ListTowerMap_put(ListTowerMap * map, ListNode * key,
+        ListTower * tower)
+{
+    // keep the load under one half so probes stay short
+    if ((map->count + 1) * 2 > map->capacity) {
+        check(ListTowerMap_grow(map) == 0, "Failed to grow tower map.");
+    }
+
+    int i = ListTowerMap_slot(map, key);
+    if (map->keys[i] == NULL) {
+        map->count++;
+    }
+    map->keys[i] = key;
+    map->towers[i] = tower;
+
+    return 0;
+
+error:
+    return -1;
+}
+
+static inline ListTower *ListTowerMap_get(ListTowerMap * map, ListNode * key)
+{
+    return map->towers[ListTowerMap_slot(map, key)];
+}
+
+static void ListTowerMap_delete(ListTowerMap * map, ListNode * key)
+{
+    size_t mask = map->capacity - 1;
+    size_t i = ListTowerMap_slot(map, key);
+    size_t j = i;
+
+    if (map->keys[i] == NULL) {
+        return;
+    }
+
+    // backward shift: pull up later entries whose home slot is not
+    // cyclically inside (i, j], so no tombstones are needed
+    while (1) {
+        j = (j + 1) & mask;
+        if (map->keys[j] == NULL) {
+            break;
+        }
+
+        size_t home = ListTowerMap_hash(map->keys[j]) & mask;
+        int stays = i <= j ? (home > i && home <= j)
+            : (home > i || home <= j);
+        if (!stays) {
+            map->keys[i] = map->keys[j];
+            map->towers[i] = map->towers[j];
+            i = j;
+        }
+    }
+
+    map->keys[i] = NULL;
+    map->towers[i] = NULL;
+    map->count--;
+}
+
+static inline ListTower *ListTower_create(ListNode * node, int height)
+{
+    ListTower *tower = malloc(sizeof(ListTower)
+            + height * sizeof(ListTowerLink));
+    check_mem(tower);
+
+    tower->node = node;
+    tower->height = height;
+
+    return tower;
+
+error:
+    return NULL;
+}
+
+// xorshift32, then one more level for every pair of zero bits
+static inline int ListIndex_random_height(ListIndex * index)
+{
+    unsigned int x = index->seed;
+    int height = 0;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    index->seed = x;
+
+    while ((x & 3) == 0 && height < LIST_INDEX_MAX_LEVEL - 1) {
+        height++;
+        x >>= 2;
+    }
+
+    return height;
+}
+
+static ListIndex *ListIndex_create(ListTowerMap * map, int count)
+{
+    ListIndex *index = calloc(1, sizeof(ListIndex));
+    check_mem(index);
+
+    index->seed = 2463534242U;
+    index->head = ListTower_create(NULL, LIST_INDEX_MAX_LEVEL);
+    check_mem(index->head);
+
+    int level = 0;
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        index->head->links[level].next = NULL;
+        index->head->links[level].prev = NULL;
+        index->head->links[level].span = count + 1;
+    }
+
+    if (map) {
+        map->refcount++;
+        index->map = map;
+    } else {
+        index->map = ListTowerMap_create(LIST_TOWER_MAP_MIN);
+        check_mem(index->map);
+    }
+
+    return index;
+
+error:
+    if (index) {
+        free(index->head);
+        free(index);
+    }
+    return NULL;
+}
+
+// Fills update[level] with the last tower at or before rank on each
+// level, and ranks[level] with its position.
+static inline void ListIndex_find(ListIndex * index, int rank,
+        ListTower ** update, int *ranks)
+{
+    ListTower *x = index->head;
+    int pos = -1;
+    int level = 0;
+
+    for (level = LIST_INDEX_MAX_LEVEL - 1; level >= 0; level--) {
+        while (x->links[level].next
+                && pos + x->links[level].span <= rank) {
+            pos += x->links[level].span;
+            x = x->links[level].next;
+        }
+        update[level] = x;
+        ranks[level] = pos;
+    }
+}
+
+static void ListIndex_clear_towers(ListIndex * index)
+{
+    ListTower *tower = index->head->links[0].next;
+
+    while (tower) {
+        ListTower *next = tower->links[0].next;
+        ListTowerMap_delete(index->map, tower->node);
+        free(tower);
+        tower = next;
+    }
+}
+
+void ListIndex_destroy(ListIndex * index)
+{
+    if (index) {
+        ListIndex_clear_towers(index);
+        ListTowerMap_release(index->map);
+        free(index->head);
+        free(index);
+    }
+}
+
+int ListIndex_rebuild(List * list)
+{
+    ListIndex *index = list->index;
+    ListTower *last[LIST_INDEX_MAX_LEVEL];
+    int last_rank[LIST_INDEX_MAX_LEVEL];
+    int level = 0;
+    int rank = 0;
+
+    check(index, "List has no index.");
+
+    ListIndex_clear_towers(index);
+
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        last[level] = index->head;
+        last_rank[level] = -1;
+    }
+
+    LIST_FOREACH(list, first, next, cur) {
+        int height = ListIndex_random_height(index);
+
+        if (height > 0) {
+            ListTower *tower = ListTower_create(cur, height);
+
+            // a node without a tower is always valid, so on failure
+            // the index just gets a little sparser
+            if (tower && ListTowerMap_put(index->map, cur, tower) == 0) {
+                for (level = 0; level < height; level++) {
+                    last[level]->links[level].next = tower;
+                    last[level]->links[level].span = rank - last_rank[level];
+                    tower->links[level].prev = last[level];
+                    last[level] = tower;
+                    last_rank[level] = rank;
+                }
+            } else {
+                free(tower);
+            }
+        }
+
+        rank++;
+    }
+
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        last[level]->links[level].next = NULL;
+        last[level]->links[level].span = list->count - last_rank[level];
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int List_index(List * list)
+{
+    check(list, "List is NULL");
+
+    if (list->index == NULL) {
+        list->index = ListIndex_create(NULL, list->count);
+        check_mem(list->index);
+    }
+
+    return ListIndex_rebuild(list);
+
+error:
+    return -1;
+}
+
+void List_unindex(List * list)
+{
+    if (list && list->index) {
+        ListIndex_destroy(list->index);
+        list->index = NULL;
+    }
+}
+
+ListNode *ListIndex_node_at(List * list, int rank)
+{
+    ListTower *update[LIST_INDEX_MAX_LEVEL];
+    int ranks[LIST_INDEX_MAX_LEVEL];
+
+    ListIndex_find(list->index, rank, update, ranks);
+
+    ListNode *node = update[0]->node;
+    int pos = ranks[0];
+    if (node == NULL) {
+        node = list->first;
+        pos = 0;
+    }
+
+    while (pos < rank) {
+        node = node->next;
+        pos++;
+    }
+
+    return node;
+}
+
+void ListIndex_added(List * list, ListNode * node, int rank)
+{
+    ListIndex *index = list->index;
+    ListTower *update[LIST_INDEX_MAX_LEVEL];
+    int ranks[LIST_INDEX_MAX_LEVEL];
+    ListTower *tower = NULL;
+    int height = ListIndex_random_height(index);
+    int level = 0;
+
+    ListIndex_find(index, rank - 1, update, ranks);
+
+    if (height > 0) {
+        tower = ListTower_create(node, height);
+        if (tower == NULL || ListTowerMap_put(index->map, node, tower) != 0) {
+            free(tower);
+            tower = NULL;
+            height = 0;
+        }
+    }
+
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        ListTowerLink *link = &update[level]->links[level];
+
+        if (level < height) {
+            // the old span ended ranks + span, which is now one further
+            tower->links[level].next = link->next;
+            tower->links[level].prev = update[level];
+            tower->links[level].span = ranks[level] + link->span + 1 - rank;
+            if (link->next) {
+                link->next->links[level].prev = tower;
+            }
+            link->next = tower;
+            link->span = rank - ranks[level];
+        } else {
+            link->span++;
+        }
+    }
+}
+
+void ListIndex_removing(List * list, ListNode * node)
+{
+    ListIndex *index = list->index;
+    ListTower *tower = ListTowerMap_get(index->map, node);
+    ListTower *cover = NULL;
+    int level = 0;
+
+    if (tower) {
+        for (level = 0; level < tower->height; level++) {
+            ListTowerLink *link = &tower->links[level];
+            ListTower *prev = link->prev;
+
+            prev->links[level].next = link->next;
+            prev->links[level].span += link->span - 1;
+            if (link->next) {
+                link->next->links[level].prev = prev;
+            }
+        }
+
+        cover = tower->links[tower->height - 1].prev;
+        ListTowerMap_delete(index->map, node);
+        free(tower);
+    } else {
+        // the nearest tower before the node covers it on low levels
+        ListNode *cur = node->prev;
+        while (cur && (cover = ListTowerMap_get(index->map, cur)) == NULL) {
+            cur = cur->prev;
+        }
+
+        if (cover == NULL) {
+            cover = index->head;
+        }
+    }
+
+    // climb back along each tower's top level to find the link that
+    // spans over the node on every remaining level
+    for (; level < LIST_INDEX_MAX_LEVEL; level++) {
+        while (cover->height <= level) {
+            cover = cover->links[cover->height - 1].prev;
+        }
+        cover->links[level].span--;
+    }
+}
+
+ListIndex *ListIndex_split(List * list, int rank)
+{
+    ListIndex *index = list->index;
+    ListTower *update[LIST_INDEX_MAX_LEVEL];
+    int ranks[LIST_INDEX_MAX_LEVEL];
+    int level = 0;
+
+    ListIndex *new_index = ListIndex_create(index->map, 0);
+    check_mem(new_index);
+
+    ListIndex_find(index, rank - 1, update, ranks);
+
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        ListTowerLink *link = &update[level]->links[level];
+        ListTowerLink *head = &new_index->head->links[level];
+
+        head->next = link->next;
+        head->span = ranks[level] + link->span - rank + 1;
+        if (link->next) {
+            link->next->links[level].prev = new_index->head;
+        }
+
+        link->next = NULL;
+        link->span = rank - ranks[level];
+    }
+
+    return new_index;
+
+error:
+    return NULL;
+}
+
+void ListIndex_join(List * list1, List * list2, int count1)
+{
+    ListTower *update[LIST_INDEX_MAX_LEVEL];
+    int ranks[LIST_INDEX_MAX_LEVEL];
+    ListIndex *index2 = list2->index;
+    int level = 0;
+
+    ListIndex_find(list1->index, count1 - 1, update, ranks);
+
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        ListTowerLink *link = &update[level]->links[level];
+        ListTowerLink *head = &index2->head->links[level];
+
+        link->next = head->next;
+        link->span += head->span - 1;
+        if (head->next) {
+            head->next->links[level].prev = update[level];
+        }
+    }
+
+    // the towers now belong to list1, only the head goes
+    ListTowerMap_release(index2->map);
+    free(index2->head);
+    free(index2);
+    list2->index = NULL;
+}
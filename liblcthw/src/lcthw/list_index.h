@@ -0,0 +1,63 @@
+#ifndef lcthw_List_index_h
+#define lcthw_List_index_h
+
+#include <lcthw/list.h>
+
+#define LIST_INDEX_MAX_LEVEL 32
+
+struct ListTower;
+
+// One level of a tower. span counts the list nodes from this tower's
+// node to next's node; the last tower on a level spans to a virtual
+// tail one past the end of the list.
+typedef struct ListTowerLink {
+    struct ListTower *next;
+    struct ListTower *prev;
+    int span;
+} ListTowerLink;
+
+// Skip list levels above a list node. The head tower of an index has
+// no node, sits at position -1 and is LIST_INDEX_MAX_LEVEL high.
+typedef struct ListTower {
+    ListNode *node;
+    int height;
+    ListTowerLink links[];
+} ListTower;
+
+// Open addressing map from a node to its tower. Lists split off an
+// indexed list share their parent's map, so splits move no entries.
+typedef struct ListTowerMap {
+    int refcount;
+    int count;
+    int capacity;
+    ListNode **keys;
+    ListTower **towers;
+} ListTowerMap;
+
+// Indexable skip list keyed by position with span counts. Level 0 is
+// the list itself, about one node in four gets a tower.
+typedef struct ListIndex {
+    unsigned int seed;
+    ListTower *head;
+    ListTowerMap *map;
+} ListIndex;
+
+// Builds an index over list in O(n). Once indexed, List_node_at,
+// List_get, List_insert and List_split take O(log n) and the plain
+// List operations keep the index in sync. Returns 0 or -1.
+int List_index(List * list);
+void List_unindex(List * list);
+
+// Hooks called by list.c; the list's links and count are already
+// updated for added, and not yet for removing. split is called before
+// the nodes are cut and join after they are linked, with list1's old
+// count.
+void ListIndex_added(List * list, ListNode * node, int rank);
+void ListIndex_removing(List * list, ListNode * node);
+ListNode *ListIndex_node_at(List * list, int rank);
+ListIndex *ListIndex_split(List * list, int rank);
+void ListIndex_join(List * list1, List * list2, int count1);
+int ListIndex_rebuild(List * list);
+void ListIndex_destroy(ListIndex * index);
+
+#endif
@@ -0,0 +1,174 @@
+#include <lcthw/list_pool.h>
+#include <lcthw/dbg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+ListPool *ListPool_create(int slab_size)
+{
+    check(slab_size > 0, "slab_size must be > 0.");
+
+    ListPool *pool = calloc(1, sizeof(ListPool));
+    check_mem(pool);
+
+    pool->refcount = 1;
+    pool->slab_size = slab_size;
+
+    return pool;
+
+error:
+    return NULL;
+}
+
+void ListPool_retain(ListPool * pool)
+{
+    check(pool, "pool can't be NULL");
+    pool->refcount++;
+
+error:
+    return;
+}
+
+void ListPool_release(ListPool * pool)
+{
+    check(pool, "pool can't be NULL");
+
+    pool->refcount--;
+    if (pool->refcount > 0) {
+        return;
+    }
+
+    ListSlab *slab = pool->slabs;
+    while (slab) {
+        ListSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    free(pool);
+
+error:
+    return;
+}
+
+static inline ListSlab *ListPool_add_slab(ListPool * pool, int count,
+        size_t extra)
+{
+    ListSlab *slab = malloc(sizeof(ListSlab) + count * sizeof(ListNode)
+            + extra);
+    check_mem(slab);
+
+    slab->count = count;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    return slab;
+
+error:
+    return NULL;
+}
+
+// Adds a slab of at least min nodes, or the usual growth if larger.
+static inline int ListPool_grow(ListPool * pool, int min)
+{
+    int count = pool->slab_size < min ? min : pool->slab_size;
+    ListSlab *slab = ListPool_add_slab(pool, count, 0);
+    check_mem(slab);
+
+    // thread the new nodes onto the free list in address order
+    int i = 0;
+    for (i = 0; i < count - 1; i++) {
+        slab->nodes[i].next = &slab->nodes[i + 1];
+    }
+    slab->nodes[count - 1].next = pool->free_nodes;
+    pool->free_nodes = &slab->nodes[0];
+    pool->free_count += count;
+
+    if (pool->slab_size < LIST_POOL_MAX_SLAB) {
+        pool->slab_size *= 2;
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+ListNode *ListPool_alloc(ListPool * pool)
+{
+    if (pool->free_nodes == NULL) {
+        check(ListPool_grow(pool, 1) == 0, "Failed to grow list pool.");
+    }
+
+    ListNode *node = pool->free_nodes;
+    pool->free_nodes = node->next;
+    pool->free_count--;
+
+    node->next = NULL;
+    node->prev = NULL;
+    node->value = NULL;
+
+    return node;
+
+error:
+    return NULL;
+}
+
+ListNode *ListPool_alloc_many(ListPool * pool, int count)
+{
+    check(pool, "pool can't be NULL");
+    check(count > 0, "count must be > 0.");
+
+    // one slab covers the shortfall; fresh nodes go on the front of the
+    // free list, so a batch from a new slab is contiguous
+    if (pool->free_count < count) {
+        check(ListPool_grow(pool, count - pool->free_count) == 0,
+                "Failed to grow list pool.");
+    }
+
+    ListNode *first = pool->free_nodes;
+    ListNode *last = first;
+    int i = 0;
+    for (i = 1; i < count; i++) {
+        last = last->next;
+    }
+
+    pool->free_nodes = last->next;
+    pool->free_count -= count;
+    last->next = NULL;
+
+    return first;
+
+error:
+    return NULL;
+}
+
+ListNode *ListPool_alloc_block(ListPool * pool, int count)
+{
+    return ListPool_alloc_block_data(pool, count, 0, NULL);
+}
+
+ListNode *ListPool_alloc_block_data(ListPool * pool, int count,
+        size_t extra, void **data)
+{
+    check(pool, "pool can't be NULL");
+    check(count > 0, "count must be > 0.");
+    check(data || extra == 0, "data can't be NULL");
+
+    // room to round the end of the nodes up to the data alignment
+    size_t align = _Alignof(max_align_t);
+    size_t pad = extra ? align - 1 : 0;
+
+    ListSlab *slab = ListPool_add_slab(pool, count, extra + pad);
+    check_mem(slab);
+
+    if (extra) {
+        uintptr_t end = (uintptr_t)&slab->nodes[count];
+        *data = (void *)((end + align - 1) & ~(uintptr_t)(align - 1));
+        pool->data_bytes += extra;
+    }
+
+    return slab->nodes;
+
+error:
+    return NULL;
+}
@@ -0,0 +1,62 @@
+#ifndef lcthw_List_pool_h
+#define lcthw_List_pool_h
+
+#include <lcthw/list.h>
+
+#define LIST_POOL_DEFAULT_SLAB 64
+#define LIST_POOL_MAX_SLAB 65536
+
+// One contiguous block of nodes. Slabs double in size as the pool
+// grows, up to LIST_POOL_MAX_SLAB nodes each.
+typedef struct ListSlab {
+    struct ListSlab *next;
+    int count;
+    ListNode nodes[];
+} ListSlab;
+
+// Hands out ListNodes from slabs and keeps released nodes on a free
+// list (chained through ->next) for reuse. A pool can be private to
+// one List or shared by several; it is freed when the last reference
+// is released. Pools are not thread safe.
+typedef struct ListPool {
+    int refcount;
+    int slab_size;
+    int free_count;
+    ListNode *free_nodes;
+    ListSlab *slabs;
+    // bytes of caller data held after the nodes of block slabs
+    size_t data_bytes;
+} ListPool;
+
+ListPool *ListPool_create(int slab_size);
+void ListPool_retain(ListPool * pool);
+void ListPool_release(ListPool * pool);
+
+ListNode *ListPool_alloc(ListPool * pool);
+
+// Takes count nodes off the free list at once, chained through ->next
+// and not cleared, for callers that link a whole batch in one pass.
+// A shortfall is covered by a single new slab of at least the usual
+// growth, so repeated batches reuse freed nodes instead of piling up
+// slabs.
+ListNode *ListPool_alloc_many(ListPool * pool, int count);
+
+// Allocates one slab of exactly count nodes, all handed out at once,
+// for callers that link a whole batch in a single pass. The nodes are
+// contiguous and are not cleared.
+ListNode *ListPool_alloc_block(ListPool * pool, int count);
+
+// The same with extra bytes of storage right after the nodes, in the
+// same allocation, for values that should live and die with them.
+// *data points at the extra bytes, aligned for any type.
+ListNode *ListPool_alloc_block_data(ListPool * pool, int count,
+        size_t extra, void **data);
+
+static inline void ListPool_free(ListPool * pool, ListNode * node)
+{
+    node->next = pool->free_nodes;
+    pool->free_nodes = node;
+    pool->free_count++;
+}
+
+#endif
@@ -0,0 +1,203 @@
+#include <lcthw/lru.h>
+#include <lcthw/dbg.h>
+
+static int default_compare(const void *a, const void *b)
+{
+    return strcmp(a, b);
+}
+
+// FNV-1a
+static uint32_t default_hash(const void *key)
+{
+    const unsigned char *c = key;
+    uint32_t hash = 2166136261U;
+
+    for (; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+LRU *LRU_create(int capacity, LRU_compare compare, LRU_hash hash,
+        LRU_evict evict, void *evict_data)
+{
+    LRU *lru = NULL;
+
+    check(capacity > 0, "capacity must be > 0.");
+
+    lru = calloc(1, sizeof(LRU));
+    check_mem(lru);
+
+    lru->capacity = capacity;
+    lru->compare = compare ? compare : default_compare;
+    lru->hash = hash ? hash : default_hash;
+    lru->evict = evict;
+    lru->evict_data = evict_data;
+
+    lru->recency = List_create_inline(sizeof(LRUEntry));
+    check_mem(lru->recency);
+
+    uint32_t size = 16;
+    while (size < (uint32_t)capacity * 2) {
+        size *= 2;
+    }
+    lru->mask = size - 1;
+    lru->table = calloc(size, sizeof(ListNode *));
+    check_mem(lru->table);
+
+    return lru;
+
+error:
+    if (lru) {
+        if (lru->recency) {
+            List_destroy(lru->recency);
+        }
+        free(lru);
+    }
+    return NULL;
+}
+
+void LRU_destroy(LRU * lru)
+{
+    check(lru, "lru can't be NULL");
+
+    if (lru->evict) {
+        LIST_FOREACH(lru->recency, first, next, cur) {
+            LRUEntry *entry = cur->value;
+            lru->evict(entry->key, entry->value, lru->evict_data);
+        }
+    }
+
+    List_destroy(lru->recency);
+    free(lru->table);
+    free(lru);
+
+error:
+    return;
+}
+
+// Returns the slot holding key, or the empty slot that ends its probe.
+static inline uint32_t LRU_slot(LRU * lru, const void *key, uint32_t hash)
+{
+    uint32_t i = hash & lru->mask;
+
+    while (lru->table[i]) {
+        LRUEntry *entry = lru->table[i]->value;
+        if (entry->hash == hash && lru->compare(entry->key, key) == 0) {
+            break;
+        }
+        i = (i + 1) & lru->mask;
+    }
+
+    return i;
+}
+
+// Backward shift delete, so lookups never need tombstones.
+static void LRU_unindex(LRU * lru, ListNode * node)
+{
+    LRUEntry *entry = node->value;
+    uint32_t i = entry->hash & lru->mask;
+    uint32_t j = 0;
+
+    while (lru->table[i] != node) {
+        i = (i + 1) & lru->mask;
+    }
+
+    for (j = (i + 1) & lru->mask; lru->table[j]; j = (j + 1) & lru->mask) {
+        LRUEntry *other = lru->table[j]->value;
+        uint32_t home = other->hash & lru->mask;
+
+        // keep entries whose home lies cyclically in (i, j]
+        if (((j - home) & lru->mask) >= ((j - i) & lru->mask)) {
+            lru->table[i] = lru->table[j];
+            i = j;
+        }
+    }
+
+    lru->table[i] = NULL;
+}
+
+static inline void LRU_drop(LRU * lru, LRUEntry * entry)
+{
+    if (lru->evict) {
+        lru->evict(entry->key, entry->value, lru->evict_data);
+    }
+}
+
+void *LRU_get(LRU * lru, const void *key)
+{
+    uint32_t hash = lru->hash(key);
+    ListNode *node = lru->table[LRU_slot(lru, key, hash)];
+
+    if (node == NULL) {
+        lru->misses++;
+        return NULL;
+    }
+
+    lru->hits++;
+    List_move_first(lru->recency, node);
+
+    return ((LRUEntry *) node->value)->value;
+}
+
+int LRU_put(LRU * lru, void *key, void *value)
+{
+    uint32_t hash = lru->hash(key);
+    uint32_t slot = LRU_slot(lru, key, hash);
+    ListNode *node = lru->table[slot];
+    LRUEntry *entry = NULL;
+
+    if (node) {
+        entry = node->value;
+        LRU_drop(lru, entry);
+        entry->key = key;
+        entry->value = value;
+        List_move_first(lru->recency, node);
+        return 0;
+    }
+
+    if (LRU_count(lru) < lru->capacity) {
+        entry = List_unshift_new(lru->recency);
+        check_mem(entry);
+        node = lru->recency->first;
+    } else {
+        // recycle the least recent node for the new pair
+        node = lru->recency->last;
+        entry = node->value;
+        LRU_unindex(lru, node);
+        LRU_drop(lru, entry);
+        lru->evictions++;
+        List_move_first(lru->recency, node);
+
+        // the unindex may have shifted entries into our probe path
+        slot = LRU_slot(lru, key, hash);
+    }
+
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+    lru->table[slot] = node;
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int LRU_delete(LRU * lru, const void *key)
+{
+    uint32_t hash = lru->hash(key);
+    ListNode *node = lru->table[LRU_slot(lru, key, hash)];
+
+    if (node == NULL) {
+        return -1;
+    }
+
+    LRU_unindex(lru, node);
+    LRU_drop(lru, node->value);
+    List_remove(lru->recency, node);
+
+    return 0;
+}
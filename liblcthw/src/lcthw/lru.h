@@ -0,0 +1,61 @@
+#ifndef lcthw_LRU_h
+#define lcthw_LRU_h
+
+#include <stdint.h>
+#include <lcthw/list.h>
+
+typedef int (*LRU_compare) (const void *a, const void *b);
+typedef uint32_t(*LRU_hash) (const void *key);
+
+// Called with every pair that leaves the cache: evicted, replaced by a
+// put of the same key, deleted, or still cached at LRU_destroy.
+typedef void (*LRU_evict) (void *key, void *value, void *data);
+
+// Stored inline in the recency list's nodes.
+typedef struct LRUEntry {
+    void *key;
+    void *value;
+    uint32_t hash;
+} LRUEntry;
+
+// Least recently used cache. recency is an inline List of LRUEntry,
+// most recent first; table is an open addressing (linear probing) index
+// from key to node with at least twice capacity slots. Once full, the
+// least recent node is reused for the new pair, so a full cache does
+// no allocation.
+typedef struct LRU {
+    int capacity;
+    List *recency;
+    uint32_t mask;
+    ListNode **table;
+    LRU_compare compare;
+    LRU_hash hash;
+    LRU_evict evict;
+    void *evict_data;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+} LRU;
+
+// NULL compare and hash default to C string keys (strcmp and FNV-1a).
+// evict may be NULL.
+LRU *LRU_create(int capacity, LRU_compare compare, LRU_hash hash,
+        LRU_evict evict, void *evict_data);
+void LRU_destroy(LRU * lru);
+
+// Returns the value and marks it most recent, or NULL on a miss.
+void *LRU_get(LRU * lru, const void *key);
+
+// Adds or replaces key, evicting the least recent pair when full.
+// Returns 0 or -1.
+int LRU_put(LRU * lru, void *key, void *value);
+
+// Returns 0 if key was cached, -1 if not.
+int LRU_delete(LRU * lru, const void *key);
+
+#define LRU_count(A) List_count((A)->recency)
+#define LRU_hits(A) ((A)->hits)
+#define LRU_misses(A) ((A)->misses)
+#define LRU_evictions(A) ((A)->evictions)
+
+#endif
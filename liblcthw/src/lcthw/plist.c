@@ -0,0 +1,77 @@
+#include <lcthw/plist.h>
+#include <lcthw/dbg.h>
+
+PList *PList_push(PList * list, void *value)
+{
+    PList *node = malloc(sizeof(PList));
+    check_mem(node);
+
+    atomic_init(&node->refcount, 1);
+    node->count = PList_count(list) + 1;
+    node->value = value;
+    node->prev = PList_retain(list);
+
+    return node;
+
+error:
+    return NULL;
+}
+
+PList *PList_pop(PList * list)
+{
+    return list != NULL ? PList_retain(list->prev) : NULL;
+}
+
+PList *PList_retain(PList * list)
+{
+    if (list) {
+        atomic_fetch_add_explicit(&list->refcount, 1, memory_order_relaxed);
+    }
+
+    return list;
+}
+
+void PList_release(PList * list)
+{
+    // iterative, so dropping a long unshared chain can't blow the stack
+    while (list) {
+        if (atomic_fetch_sub_explicit(&list->refcount, 1,
+                    memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        PList *prev = list->prev;
+        free(list);
+        list = prev;
+    }
+}
+
+void *PList_get(PList * list, int i)
+{
+    check(i >= 0 && i < PList_count(list), "Index out of bounds.");
+
+    while (list->count > i + 1) {
+        list = list->prev;
+    }
+
+    return list->value;
+
+error:
+    return NULL;
+}
+
+int PList_to_array(PList * list, void **out)
+{
+    int count = PList_count(list);
+
+    check(out || count == 0, "out can't be NULL");
+
+    PLIST_FOREACH(list, cur) {
+        out[cur->count - 1] = cur->value;
+    }
+
+    return count;
+
+error:
+    return -1;
+}
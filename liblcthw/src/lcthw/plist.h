@@ -0,0 +1,52 @@
+#ifndef lcthw_PList_h
+#define lcthw_PList_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+// Persistent (immutable) list. Each node is also the version of the
+// list that ends with it: it knows its length and links back to the
+// version before it, so every version shares all older nodes. NULL is
+// the empty list.
+//
+// Nodes are reference counted. A version holds one reference to the
+// version before it; callers hold references to the versions they
+// keep. Nothing changes after creation, so any thread can read a
+// version it holds without locking, and releasing is thread safe.
+typedef struct PList {
+    atomic_int refcount;
+    int count;
+    void *value;
+    struct PList *prev;
+} PList;
+
+// Returns a new version with value appended in O(1). The caller's
+// reference to list is untouched.
+PList *PList_push(PList * list, void *value);
+
+// Returns a new reference to the version without the last value, in
+// O(1); NULL once it is empty.
+PList *PList_pop(PList * list);
+
+// Takes another reference to list, which is how to snapshot it: O(1)
+// and safe while other versions keep growing. Returns list.
+PList *PList_retain(PList * list);
+
+// Drops a reference, freeing the nodes no version uses any more. The
+// values are not freed.
+void PList_release(PList * list);
+
+#define PList_count(A) ((A) != NULL ? (A)->count : 0)
+#define PList_last(A) ((A) != NULL ? (A)->value : NULL)
+
+// Value i, counting from the oldest, in O(count - i).
+void *PList_get(PList * list, int i);
+
+// Copies the values into out oldest first; returns the count.
+int PList_to_array(PList * list, void **out);
+
+// Walks from the newest value back to the oldest.
+#define PLIST_FOREACH(L, V) PList *V = NULL;\
+for(V = (L); V != NULL; V = V->prev)
+
+#endif
@@ -0,0 +1,191 @@
+#include <lcthw/thread_slot.h>
+#include <lcthw/dbg.h>
+#include <pthread.h>
+
+#define THREAD_SLOTS_MIN 4
+
+static pthread_once_t ThreadSlot_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ThreadSlot_key;
+static int ThreadSlot_key_rc = -1;
+
+// Guards the list of tables and any change to a table's slots array.
+// Lookups only ever read the calling thread's own table, so they skip it.
+static pthread_mutex_t ThreadSlot_lock = PTHREAD_MUTEX_INITIALIZER;
+static ThreadSlots *ThreadSlot_tables = NULL;
+
+static _Thread_local ThreadSlots *ThreadSlot_mine = NULL;
+
+// Called by pthreads when a thread that has a table exits. Holding the
+// lock keeps an owner from being destroyed under its release.
+static void ThreadSlots_exit(void *data)
+{
+    ThreadSlots *table = data;
+    int i = 0;
+
+    pthread_mutex_lock(&ThreadSlot_lock);
+
+    if (table->prev) {
+        table->prev->next = table->next;
+    } else {
+        ThreadSlot_tables = table->next;
+    }
+    if (table->next) {
+        table->next->prev = table->prev;
+    }
+
+    for (i = 0; i < table->count; i++) {
+        ThreadSlot *slot = &table->slots[i];
+        if (atomic_load(&slot->owner) && slot->release) {
+            slot->release(slot->data);
+        }
+    }
+
+    pthread_mutex_unlock(&ThreadSlot_lock);
+
+    free(table->slots);
+    free(table);
+    ThreadSlot_mine = NULL;
+}
+
+static void ThreadSlot_init()
+{
+    ThreadSlot_key_rc = pthread_key_create(&ThreadSlot_key,
+            ThreadSlots_exit);
+}
+
+static ThreadSlots *ThreadSlots_get()
+{
+    ThreadSlots *table = ThreadSlot_mine;
+    if (table) {
+        return table;
+    }
+
+    check(pthread_once(&ThreadSlot_once, ThreadSlot_init) == 0
+            && ThreadSlot_key_rc == 0, "Failed to create thread key.");
+
+    table = calloc(1, sizeof(ThreadSlots));
+    check_mem(table);
+
+    check(pthread_setspecific(ThreadSlot_key, table) == 0,
+            "Failed to set thread slots.");
+
+    pthread_mutex_lock(&ThreadSlot_lock);
+    table->next = ThreadSlot_tables;
+    if (table->next) {
+        table->next->prev = table;
+    }
+    ThreadSlot_tables = table;
+    pthread_mutex_unlock(&ThreadSlot_lock);
+
+    ThreadSlot_mine = table;
+
+    return table;
+
+error:
+    free(table);
+    return NULL;
+}
+
+void *ThreadSlot_get(void *owner)
+{
+    ThreadSlots *table = ThreadSlot_mine;
+    int i = 0;
+
+    if (table == NULL) {
+        return NULL;
+    }
+
+    // most callers use one structure at a time
+    if (table->hit < table->count && atomic_load_explicit(
+                &table->slots[table->hit].owner, memory_order_relaxed) == owner) {
+        return table->slots[table->hit].data;
+    }
+
+    for (i = 0; i < table->count; i++) {
+        if (atomic_load_explicit(&table->slots[i].owner,
+                    memory_order_relaxed) == owner) {
+            table->hit = i;
+            return table->slots[i].data;
+        }
+    }
+
+    return NULL;
+}
+
+// Caller holds the lock. owner's slot, a free one, or a new one at
+// the end; NULL if the array can't grow.
+static inline ThreadSlot *ThreadSlots_find(ThreadSlots * table, void *owner)
+{
+    ThreadSlot *free_slot = NULL;
+    int i = 0;
+
+    for (i = 0; i < table->count; i++) {
+        void *other = atomic_load(&table->slots[i].owner);
+        if (other == owner) {
+            return &table->slots[i];
+        } else if (other == NULL && free_slot == NULL) {
+            free_slot = &table->slots[i];
+        }
+    }
+
+    if (free_slot) {
+        return free_slot;
+    }
+
+    if (table->count == table->max) {
+        int max = table->max ? table->max * 2 : THREAD_SLOTS_MIN;
+        ThreadSlot *slots = realloc(table->slots, max * sizeof(ThreadSlot));
+        if (slots == NULL) {
+            return NULL;
+        }
+        table->slots = slots;
+        table->max = max;
+    }
+
+    ThreadSlot *slot = &table->slots[table->count++];
+    atomic_init(&slot->owner, NULL);
+
+    return slot;
+}
+
+int ThreadSlot_set(void *owner, void *data, ThreadSlot_release release)
+{
+    check(owner, "owner can't be NULL");
+
+    ThreadSlots *table = ThreadSlots_get();
+    check(table, "Failed to get thread slots.");
+
+    pthread_mutex_lock(&ThreadSlot_lock);
+    ThreadSlot *slot = ThreadSlots_find(table, owner);
+    if (slot) {
+        slot->data = data;
+        slot->release = release;
+        atomic_store(&slot->owner, owner);
+    }
+    pthread_mutex_unlock(&ThreadSlot_lock);
+
+    check_mem(slot);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+void ThreadSlot_drop(void *owner)
+{
+    ThreadSlots *table = NULL;
+    int i = 0;
+
+    pthread_mutex_lock(&ThreadSlot_lock);
+
+    for (table = ThreadSlot_tables; table != NULL; table = table->next) {
+        for (i = 0; i < table->count; i++) {
+            if (atomic_load(&table->slots[i].owner) == owner) {
+                atomic_store(&table->slots[i].owner, NULL);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&ThreadSlot_lock);
+}
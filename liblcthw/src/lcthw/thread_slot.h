@@ -0,0 +1,44 @@
+#ifndef lcthw_Thread_slot_h
+#define lcthw_Thread_slot_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+// Called with a thread's data when the thread exits while its owner
+// is still alive.
+typedef void (*ThreadSlot_release) (void *data);
+
+// One thread's data for one owner. owner is NULL for a free slot.
+typedef struct ThreadSlot {
+    _Atomic(void *) owner;
+    void *data;
+    ThreadSlot_release release;
+} ThreadSlot;
+
+// Every thread's slots, one table per thread behind a single
+// process-wide pthread key. Structures that keep per thread state
+// (CQueue hazard records, CList readers) look it up here by their own
+// address, so there is no per object key and no PTHREAD_KEYS_MAX cap
+// on how many of them can be alive at once.
+typedef struct ThreadSlots {
+    struct ThreadSlots *next;
+    struct ThreadSlots *prev;
+    ThreadSlot *slots;
+    int count;
+    int max;
+    // the slot found last, checked first
+    int hit;
+} ThreadSlots;
+
+// This thread's data for owner, or NULL. Takes no lock.
+void *ThreadSlot_get(void *owner);
+
+// Sets this thread's data for owner; release runs on it if the thread
+// exits first. Returns 0 or -1.
+int ThreadSlot_set(void *owner, void *data, ThreadSlot_release release);
+
+// Forgets owner in every thread, without releasing. Call it when the
+// owner is destroyed, before its memory can be reused.
+void ThreadSlot_drop(void *owner);
+
+#endif
@@ -0,0 +1,309 @@
+#include <lcthw/ulist.h>
+#include <lcthw/dbg.h>
+
+UList *UList_create()
+{
+    return calloc(1, sizeof(UList));
+}
+
+void UList_clear(UList * list)
+{
+    check(list, "UList is NULL");
+
+    ULIST_FOREACH(list, node, i, value) {
+        free(value);
+    }
+
+error:
+    return;
+}
+
+void UList_destroy(UList * list)
+{
+    check(list, "UList is NULL");
+
+    UListNode *node = list->first;
+    while (node) {
+        UListNode *next = node->next;
+        free(node);
+        node = next;
+    }
+
+    free(list);
+
+error:
+    return;
+}
+
+void UList_clear_destroy(UList * list)
+{
+    UList_clear(list);
+    UList_destroy(list);
+}
+
+static inline UListNode *UListNode_create(int start)
+{
+    UListNode *node = malloc(sizeof(UListNode));
+    check_mem(node);
+
+    node->next = NULL;
+    node->prev = NULL;
+    node->start = start;
+    node->count = 0;
+
+    return node;
+
+error:
+    return NULL;
+}
+
+static inline void UList_unlink(UList * list, UListNode * node)
+{
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->last = node->prev;
+    }
+
+    free(node);
+}
+
+static inline void UList_link_after(UList * list, UListNode * node,
+        UListNode * after)
+{
+    node->prev = after;
+    node->next = after->next;
+
+    if (after->next) {
+        after->next->prev = node;
+    } else {
+        list->last = node;
+    }
+
+    after->next = node;
+}
+
+void UList_push(UList * list, void *value)
+{
+    check(list, "UList is NULL");
+
+    UListNode *node = list->last;
+
+    if (node == NULL || node->start + node->count == ULIST_NODE_CAPACITY) {
+        node = UListNode_create(0);
+        check_mem(node);
+
+        if (list->last == NULL) {
+            list->first = node;
+            list->last = node;
+        } else {
+            UList_link_after(list, node, list->last);
+        }
+    }
+
+    node->values[node->start + node->count] = value;
+    node->count++;
+    list->count++;
+
+error:
+    return;
+}
+
+void *UList_pop(UList * list)
+{
+    UListNode *node = list->last;
+    if (node == NULL) {
+        return NULL;
+    }
+
+    node->count--;
+    list->count--;
+    void *value = node->values[node->start + node->count];
+
+    if (node->count == 0) {
+        UList_unlink(list, node);
+    }
+
+    return value;
+}
+
+void UList_unshift(UList * list, void *value)
+{
+    check(list, "UList is NULL");
+
+    UListNode *node = list->first;
+
+    // new front nodes fill from the back so later unshifts fit
+    if (node == NULL || node->start == 0) {
+        node = UListNode_create(ULIST_NODE_CAPACITY);
+        check_mem(node);
+
+        if (list->first == NULL) {
+            list->last = node;
+        } else {
+            node->next = list->first;
+            list->first->prev = node;
+        }
+        list->first = node;
+    }
+
+    node->start--;
+    node->values[node->start] = value;
+    node->count++;
+    list->count++;
+
+error:
+    return;
+}
+
+void *UList_shift(UList * list)
+{
+    UListNode *node = list->first;
+    if (node == NULL) {
+        return NULL;
+    }
+
+    void *value = node->values[node->start];
+    node->start++;
+    node->count--;
+    list->count--;
+
+    if (node->count == 0) {
+        UList_unlink(list, node);
+    }
+
+    return value;
+}
+
+void *UList_remove(UList * list, UListNode * node, int i)
+{
+    void *result = NULL;
+
+    check(list->first && list->last, "UList is empty.");
+    check(node, "node can't be NULL");
+    check(i >= node->start && i < node->start + node->count,
+            "Slot %d is not in use in this node.", i);
+
+    result = node->values[i];
+
+    if (i == node->start) {
+        // removing from the front of a node is just a bump
+        node->start++;
+    } else {
+        int end = node->start + node->count;
+        memmove(&node->values[i], &node->values[i + 1],
+                (end - i - 1) * sizeof(void *));
+    }
+
+    node->count--;
+    list->count--;
+
+    if (node->count == 0) {
+        UList_unlink(list, node);
+    } else if (node->next && node->count + node->next->count
+            <= ULIST_NODE_CAPACITY / 2) {
+        // keep nodes at least half full after removals from the middle
+        UListNode *next = node->next;
+        memmove(&node->values[0], &node->values[node->start],
+                node->count * sizeof(void *));
+        memcpy(&node->values[node->count], &next->values[next->start],
+                next->count * sizeof(void *));
+        node->start = 0;
+        node->count += next->count;
+        UList_unlink(list, next);
+    }
+
+error:
+    return result;
+}
+
+void UList_join(UList * list1, UList * list2)
+{
+    check(list1, "List1 is NULL");
+    check(list2, "List2 is NULL");
+
+    if (list2->first == NULL) {
+        return;
+    }
+
+    if (list1->last == NULL) {
+        list1->first = list2->first;
+    } else {
+        list1->last->next = list2->first;
+        list2->first->prev = list1->last;
+    }
+
+    list1->last = list2->last;
+    list1->count += list2->count;
+
+    list2->first = NULL;
+    list2->last = NULL;
+    list2->count = 0;
+
+error:
+    return;
+}
+
+UList *UList_split(UList * list, int index)
+{
+    UList *new_list = NULL;
+
+    check(list != NULL, "UList is NULL.");
+    check(index >= 0 && index <= list->count, "Index out of bounds.");
+
+    new_list = UList_create();
+    check_mem(new_list);
+
+    // skip whole nodes until the one holding position index
+    UListNode *node = list->first;
+    int pos = 0;
+    while (node && pos + node->count <= index) {
+        pos += node->count;
+        node = node->next;
+    }
+
+    if (node == NULL) {
+        return new_list;
+    }
+
+    int offset = index - pos;
+    if (offset > 0) {
+        // split the node itself, the tail goes into a fresh node
+        UListNode *tail = UListNode_create(0);
+        check_mem(tail);
+
+        tail->count = node->count - offset;
+        memcpy(&tail->values[0], &node->values[node->start + offset],
+                tail->count * sizeof(void *));
+        node->count = offset;
+
+        UList_link_after(list, tail, node);
+        node = tail;
+    }
+
+    new_list->first = node;
+    new_list->last = list->last;
+    new_list->count = list->count - index;
+
+    list->last = node->prev;
+    if (list->last) {
+        list->last->next = NULL;
+    } else {
+        list->first = NULL;
+    }
+    list->count = index;
+
+    node->prev = NULL;
+
+    return new_list;
+
+error:
+    free(new_list);
+    return NULL;
+}
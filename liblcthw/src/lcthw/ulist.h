@@ -0,0 +1,59 @@
+#ifndef lcthw_UList_h
+#define lcthw_UList_h
+
+#include <stdlib.h>
+
+// Values per node. 29 pointers plus the 24 byte header fill four
+// 64 byte cache lines.
+#define ULIST_NODE_CAPACITY 29
+
+// Unrolled list: each node holds up to ULIST_NODE_CAPACITY values in
+// values[start .. start + count), so traversal touches contiguous
+// memory and the ends stay O(1).
+typedef struct UListNode {
+    struct UListNode *next;
+    struct UListNode *prev;
+    int start;
+    int count;
+    void *values[ULIST_NODE_CAPACITY];
+} UListNode;
+
+typedef struct UList {
+    int count;
+    UListNode *first;
+    UListNode *last;
+} UList;
+
+UList *UList_create();
+void UList_clear(UList * list);
+void UList_destroy(UList * list);
+void UList_clear_destroy(UList * list);
+
+#define UList_count(A) ((A)->count)
+#define UList_first(A) ((A)->first != NULL ?\
+        (A)->first->values[(A)->first->start] : NULL)
+#define UList_last(A) ((A)->last != NULL ?\
+        (A)->last->values[(A)->last->start + (A)->last->count - 1] : NULL)
+
+void UList_push(UList * list, void *value);
+void *UList_pop(UList * list);
+
+void UList_unshift(UList * list, void *value);
+void *UList_shift(UList * list);
+
+// list2 is left empty and can be destroyed afterwards.
+void UList_join(UList * list1, UList * list2);
+UList *UList_split(UList * list, int index);
+
+// Removes the value in slot i of node, as found by ULIST_FOREACH.
+void *UList_remove(UList * list, UListNode * node, int i);
+
+// Declares N (current node), I (slot index) and V (value). This is a
+// nested loop, so use goto rather than break to leave it early.
+#define ULIST_FOREACH(L, N, I, V) UListNode *N = NULL;\
+                                  int I = 0;\
+                                  void *V = NULL;\
+for(N = (L)->first; N != NULL; N = N->next)\
+    for(I = N->start; I < N->start + N->count && ((V = N->values[I]), 1); I++)
+
+#endif
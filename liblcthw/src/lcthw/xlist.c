@@ -0,0 +1,202 @@
+#include <lcthw/xlist.h>
+#include <lcthw/dbg.h>
+
+XList *XList_create()
+{
+    XList *list = calloc(1, sizeof(XList));
+    check_mem(list);
+
+    list->slab_size = XLIST_DEFAULT_SLAB;
+
+    return list;
+
+error:
+    return NULL;
+}
+
+void XList_clear(XList * list)
+{
+    check(list, "List is NULL");
+
+    XLIST_FOREACH(list, first, cur) {
+        free(cur->value);
+    }
+
+error:
+    return;
+}
+
+void XList_destroy(XList * list)
+{
+    check(list, "List is NULL");
+
+    XListSlab *slab = list->slabs;
+    while (slab) {
+        XListSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    free(list);
+
+error:
+    return;
+}
+
+void XList_clear_destroy(XList * list)
+{
+    check(list, "List is NULL");
+
+    XList_clear(list);
+    XList_destroy(list);
+
+error:
+    return;
+}
+
+static inline int XList_grow(XList * list)
+{
+    int count = list->slab_size;
+    XListSlab *slab = malloc(sizeof(XListSlab) + count * sizeof(XListNode));
+    check_mem(slab);
+
+    slab->count = count;
+    slab->next = list->slabs;
+    list->slabs = slab;
+
+    // thread the new nodes onto the free list in address order
+    int i = 0;
+    for (i = 0; i < count - 1; i++) {
+        slab->nodes[i].link = (uintptr_t)&slab->nodes[i + 1];
+    }
+    slab->nodes[count - 1].link = (uintptr_t)list->free_nodes;
+    list->free_nodes = &slab->nodes[0];
+
+    if (list->slab_size < XLIST_MAX_SLAB) {
+        list->slab_size *= 2;
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+static inline XListNode *XList_alloc(XList * list)
+{
+    if (list->free_nodes == NULL) {
+        check(XList_grow(list) == 0, "Failed to grow list.");
+    }
+
+    XListNode *node = list->free_nodes;
+    list->free_nodes = (XListNode *)node->link;
+
+    return node;
+
+error:
+    return NULL;
+}
+
+static inline void XList_free(XList * list, XListNode * node)
+{
+    node->link = (uintptr_t)list->free_nodes;
+    list->free_nodes = node;
+}
+
+// push and unshift are mirror images, as are pop and shift: each works
+// on one end and only touches the other when the list empties or fills.
+static inline void XList_add(XList * list, XListNode ** end,
+        XListNode ** other, void *value)
+{
+    XListNode *node = XList_alloc(list);
+    check_mem(node);
+
+    node->value = value;
+    node->link = (uintptr_t)*end;
+
+    if (*end == NULL) {
+        *other = node;
+    } else {
+        (*end)->link ^= (uintptr_t)node;
+    }
+
+    *end = node;
+    list->count++;
+
+error:
+    return;
+}
+
+static inline void *XList_take(XList * list, XListNode ** end,
+        XListNode ** other)
+{
+    XListNode *node = *end;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    // the end node's link is just its one neighbour
+    XListNode *next = (XListNode *)node->link;
+    if (next == NULL) {
+        *other = NULL;
+    } else {
+        next->link ^= (uintptr_t)node;
+    }
+
+    *end = next;
+    list->count--;
+
+    void *value = node->value;
+    XList_free(list, node);
+
+    return value;
+}
+
+void XList_push(XList * list, void *value)
+{
+    check(list, "List is NULL");
+    XList_add(list, &list->last, &list->first, value);
+
+error:
+    return;
+}
+
+void *XList_pop(XList * list)
+{
+    check(list, "List is NULL");
+    return XList_take(list, &list->last, &list->first);
+
+error:
+    return NULL;
+}
+
+void XList_unshift(XList * list, void *value)
+{
+    check(list, "List is NULL");
+    XList_add(list, &list->first, &list->last, value);
+
+error:
+    return;
+}
+
+void *XList_shift(XList * list)
+{
+    check(list, "List is NULL");
+    return XList_take(list, &list->first, &list->last);
+
+error:
+    return NULL;
+}
+
+size_t XList_memory(XList * list)
+{
+    size_t total = sizeof(XList);
+
+    XListSlab *slab = NULL;
+    for (slab = list->slabs; slab != NULL; slab = slab->next) {
+        total += sizeof(XListSlab) + slab->count * sizeof(XListNode);
+    }
+
+    return total;
+}
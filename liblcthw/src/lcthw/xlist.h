@@ -0,0 +1,70 @@
+#ifndef lcthw_XList_h
+#define lcthw_XList_h
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#define XLIST_DEFAULT_SLAB 64
+#define XLIST_MAX_SLAB 65536
+
+// Compact node: link is prev XOR next, so the node is two words. Given
+// either neighbour the other one falls out of the link, which is all a
+// walk from one end needs.
+typedef struct XListNode {
+    uintptr_t link;
+    void *value;
+} XListNode;
+
+// Nodes come from slabs that double up to XLIST_MAX_SLAB, the same way
+// ListPool hands out ListNodes; freed nodes are chained through link.
+typedef struct XListSlab {
+    struct XListSlab *next;
+    int count;
+    XListNode nodes[];
+} XListSlab;
+
+// XOR-linked list for long lists of small values. It keeps the List
+// queue API but there is no O(1) remove or split from the middle,
+// since a node alone doesn't say where its neighbours are.
+typedef struct XList {
+    int count;
+    XListNode *first;
+    XListNode *last;
+    int slab_size;
+    XListNode *free_nodes;
+    XListSlab *slabs;
+} XList;
+
+XList *XList_create();
+void XList_clear(XList * list);
+void XList_destroy(XList * list);
+void XList_clear_destroy(XList * list);
+
+#define XList_count(A) ((A)->count)
+#define XList_first(A) ((A)->first != NULL ? (A)->first->value : NULL)
+#define XList_last(A) ((A)->last != NULL ? (A)->last->value : NULL)
+
+void XList_push(XList * list, void *value);
+void *XList_pop(XList * list);
+
+void XList_unshift(XList * list, void *value);
+void *XList_shift(XList * list);
+
+// The neighbour of node that isn't from.
+static inline XListNode *XList_step(XListNode * from, XListNode * node)
+{
+    return (XListNode *)(node->link ^ (uintptr_t)from);
+}
+
+// Bytes held by the list's slabs, for comparing its footprint.
+size_t XList_memory(XList * list);
+
+// Walks list L from S (first or last) to the other end, binding V to
+// each node.
+#define XLIST_FOREACH(L, S, V) XListNode *_xfrom = NULL;\
+                               XListNode *_xnext = NULL;\
+                               XListNode *V = NULL;\
+for(V = (L)->S; V != NULL;\
+        _xnext = XList_step(_xfrom, V), _xfrom = V, V = _xnext)
+
+#endif
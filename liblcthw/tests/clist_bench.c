@@ -0,0 +1,128 @@
+#include "bench.h"
+#include <lcthw/clist.h>
+#include <lcthw/list.h>
+
+#define MAX_THREADS 32
+#define LIST_SIZE 1000
+
+// The baseline: a List behind a reader/writer lock.
+static pthread_rwlock_t rwlock = PTHREAD_RWLOCK_INITIALIZER;
+static List *locked = NULL;
+static CList *clist = NULL;
+
+static int ops_per_thread = 0;
+static int write_percent = 0;
+static char *value = "bench";
+
+// Reads walk the whole list; writes alternate push and shift so the
+// size stays put.
+static void *clist_worker(void *arg)
+{
+    unsigned int seed = (unsigned int)(size_t)arg;
+    size_t sum = 0;
+    int i = 0;
+
+    for (i = 0; i < ops_per_thread; i++) {
+        if ((int)(rand_r(&seed) % 100) < write_percent) {
+            if (i % 2) {
+                CList_push(clist, value);
+            } else {
+                CList_shift(clist);
+            }
+        } else {
+            CList_read_lock(clist);
+            CLIST_FOREACH(clist, cur) {
+                sum += (size_t)cur->value;
+            }
+            CList_read_unlock(clist);
+        }
+    }
+
+    return (void *)sum;
+}
+
+static void *locked_worker(void *arg)
+{
+    unsigned int seed = (unsigned int)(size_t)arg;
+    size_t sum = 0;
+    int i = 0;
+
+    for (i = 0; i < ops_per_thread; i++) {
+        if ((int)(rand_r(&seed) % 100) < write_percent) {
+            pthread_rwlock_wrlock(&rwlock);
+            if (i % 2) {
+                List_push(locked, value);
+            } else {
+                List_shift(locked);
+            }
+            pthread_rwlock_unlock(&rwlock);
+        } else {
+            pthread_rwlock_rdlock(&rwlock);
+            LIST_FOREACH(locked, first, next, cur) {
+                sum += (size_t)cur->value;
+            }
+            pthread_rwlock_unlock(&rwlock);
+        }
+    }
+
+    return (void *)sum;
+}
+
+static double run(int nthreads, int ops, void *(*worker)(void *))
+{
+    pthread_t threads[MAX_THREADS];
+    double secs = 0;
+    size_t i = 0;
+
+    ops_per_thread = ops / nthreads;
+
+    BENCH(secs, {
+        for (i = 0; i < (size_t)nthreads; i++) {
+            pthread_create(&threads[i], NULL, worker, (void *)(i + 1));
+        }
+        for (i = 0; i < (size_t)nthreads; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    });
+
+    return secs;
+}
+
+int main(int argc, char *argv[])
+{
+    int ops = bench_max_n(argc, argv, 20000);
+    int mixes[] = { 5, 50 };
+    int m = 0;
+    int nthreads = 0;
+    int i = 0;
+    char name[64];
+
+    printf("----\nBENCH: CList vs rwlock + List, %d element list\n",
+            LIST_SIZE);
+
+    clist = CList_create();
+    locked = List_create();
+    for (i = 0; i < LIST_SIZE; i++) {
+        CList_push(clist, value);
+        List_push(locked, value);
+    }
+
+    for (m = 0; m < 2; m++) {
+        write_percent = mixes[m];
+
+        for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2) {
+            snprintf(name, sizeof(name), "rwlock List %d%%w %dt",
+                    write_percent, nthreads);
+            bench_report(name, ops, run(nthreads, ops, locked_worker));
+
+            snprintf(name, sizeof(name), "CList %d%%w %dt",
+                    write_percent, nthreads);
+            bench_report(name, ops, run(nthreads, ops, clist_worker));
+        }
+    }
+
+    List_destroy(locked);
+    CList_destroy(clist);
+
+    return 0;
+}
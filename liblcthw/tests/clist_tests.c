@@ -0,0 +1,224 @@
+#include "minunit.h"
+#include <lcthw/clist.h>
+#include <stdint.h>
+#include <sched.h>
+
+#define PUSHERS 2
+#define REMOVERS 3
+#define READERS 4
+#define PER_PUSHER 20000
+#define TOTAL (PUSHERS * PER_PUSHER)
+
+static CList *list = NULL;
+static atomic_int removed;
+static atomic_int done;
+static atomic_int bad_reads;
+static atomic_char seen[TOTAL];
+
+// Values are 1 + pusher * PER_PUSHER + seq, so none are NULL.
+static void *pusher(void *arg)
+{
+    intptr_t id = (intptr_t)arg;
+    int seq = 0;
+
+    for (seq = 0; seq < PER_PUSHER; seq++) {
+        void *value = (void *)(1 + id * PER_PUSHER + seq);
+        if (seq % 2) {
+            CList_push(list, value);
+        } else {
+            CList_unshift(list, value);
+        }
+    }
+
+    return NULL;
+}
+
+static void take(intptr_t value)
+{
+    atomic_fetch_add(&seen[value - 1], 1);
+    atomic_fetch_add(&removed, 1);
+}
+
+// Removes from both ends and from the middle of the list.
+static void *remover(void *arg)
+{
+    int turn = 0;
+    (void)arg;
+
+    while (atomic_load(&removed) < TOTAL) {
+        intptr_t value = 0;
+
+        if (turn % 3 == 0) {
+            value = (intptr_t)CList_shift(list);
+        } else if (turn % 3 == 1) {
+            value = (intptr_t)CList_pop(list);
+        } else {
+            int skip = turn % 7;
+
+            CList_read_lock(list);
+            CLIST_FOREACH(list, cur) {
+                if (skip-- == 0) {
+                    value = (intptr_t)CList_remove(list, cur);
+                    break;
+                }
+            }
+            CList_read_unlock(list);
+        }
+
+        if (value) {
+            take(value);
+        } else {
+            sched_yield();
+        }
+        turn++;
+    }
+
+    return NULL;
+}
+
+static void *reader(void *arg)
+{
+    (void)arg;
+
+    while (!atomic_load(&done)) {
+        CList_read_lock(list);
+        CLIST_FOREACH(list, cur) {
+            intptr_t value = (intptr_t)cur->value;
+            if (value < 1 || value > TOTAL) {
+                atomic_fetch_add(&bad_reads, 1);
+            }
+        }
+        CList_read_unlock(list);
+    }
+
+    return NULL;
+}
+
+char *test_create()
+{
+    list = CList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+    mu_assert(CList_count(list) == 0, "New list isn't empty.");
+    mu_assert(CList_pop(list) == NULL, "Pop of empty list.");
+    mu_assert(CList_shift(list) == NULL, "Shift of empty list.");
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    char *values[] = { "one", "two", "three", "four" };
+
+    CList_push(list, values[1]);
+    CList_push(list, values[2]);
+    CList_unshift(list, values[0]);
+    CList_push(list, values[3]);
+    mu_assert(CList_count(list) == 4, "Wrong count on push.");
+
+    int i = 0;
+    CList_read_lock(list);
+    CLIST_FOREACH(list, cur) {
+        mu_assert(cur->value == values[i], "Wrong order.");
+        i++;
+    }
+
+    // remove the middle node while still reading
+    CListNode *second = atomic_load(&list->head.next)->next;
+    mu_assert(CList_remove(list, second) == values[1], "Wrong remove.");
+    mu_assert(CList_remove(list, second) == NULL, "Removed twice.");
+    CList_read_unlock(list);
+
+    mu_assert(CList_shift(list) == values[0], "Wrong value on shift.");
+    mu_assert(CList_pop(list) == values[3], "Wrong value on pop.");
+    mu_assert(CList_pop(list) == values[2], "Wrong value on pop.");
+    mu_assert(CList_count(list) == 0, "Wrong count after pop.");
+
+    CList_reclaim(list);
+    mu_assert(list->retired_count == 0, "Retired nodes weren't freed.");
+
+    return NULL;
+}
+
+char *test_concurrent()
+{
+    pthread_t threads[PUSHERS + REMOVERS + READERS];
+    intptr_t i = 0;
+    int n = 0;
+
+    atomic_init(&removed, 0);
+    atomic_init(&done, 0);
+    atomic_init(&bad_reads, 0);
+
+    for (i = 0; i < READERS; i++) {
+        mu_assert(pthread_create(&threads[n++], NULL, reader, NULL) == 0,
+                "Failed to start reader.");
+    }
+    for (i = 0; i < REMOVERS; i++) {
+        mu_assert(pthread_create(&threads[n++], NULL, remover, NULL) == 0,
+                "Failed to start remover.");
+    }
+    for (i = 0; i < PUSHERS; i++) {
+        mu_assert(pthread_create(&threads[n++], NULL, pusher,
+                    (void *)i) == 0, "Failed to start pusher.");
+    }
+
+    // the removers finish once everything pushed is gone
+    for (i = READERS; i < n; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    atomic_store(&done, 1);
+    for (i = 0; i < READERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    mu_assert(atomic_load(&bad_reads) == 0, "Reader saw a bad value.");
+    for (i = 0; i < TOTAL; i++) {
+        mu_assert(atomic_load(&seen[i]) == 1,
+                "Value lost or removed twice.");
+    }
+    mu_assert(CList_count(list) == 0, "List should be empty.");
+
+    return NULL;
+}
+
+char *test_many()
+{
+    CList *lists[2000] = { NULL };
+    int i = 0;
+
+    // more lists than a process has pthread keys
+    for (i = 0; i < 2000; i++) {
+        lists[i] = CList_create();
+        mu_assert(lists[i] != NULL, "Failed to create list.");
+        mu_assert(CList_push(lists[i], "many") == 0, "Push failed.");
+    }
+    for (i = 0; i < 2000; i++) {
+        mu_assert(CList_pop(lists[i]) != NULL, "Wrong value.");
+        CList_destroy(lists[i]);
+    }
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    CList_push(list, "left over");
+    CList_destroy(list);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_concurrent);
+    mu_run_test(test_many);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
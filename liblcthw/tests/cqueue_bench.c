@@ -0,0 +1,129 @@
+#include "bench.h"
+#include <lcthw/cqueue.h>
+#include <lcthw/list.h>
+
+#define MAX_THREADS 16
+
+// The baseline: a List behind one mutex, as work queues use it today.
+typedef struct LockedList {
+    pthread_mutex_t lock;
+    List *list;
+} LockedList;
+
+static CQueue *queue = NULL;
+static LockedList locked = { PTHREAD_MUTEX_INITIALIZER, NULL };
+static int per_thread = 0;
+static atomic_int remaining;
+
+static char *value = "bench";
+
+static void *cqueue_producer(void *arg)
+{
+    int i = 0;
+    (void)arg;
+
+    for (i = 0; i < per_thread; i++) {
+        CQueue_push(queue, value);
+    }
+
+    return NULL;
+}
+
+static void *cqueue_consumer(void *arg)
+{
+    (void)arg;
+
+    while (atomic_load(&remaining) > 0) {
+        if (CQueue_shift(queue)) {
+            atomic_fetch_sub(&remaining, 1);
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *locked_producer(void *arg)
+{
+    int i = 0;
+    (void)arg;
+
+    for (i = 0; i < per_thread; i++) {
+        pthread_mutex_lock(&locked.lock);
+        List_push(locked.list, value);
+        pthread_mutex_unlock(&locked.lock);
+    }
+
+    return NULL;
+}
+
+static void *locked_consumer(void *arg)
+{
+    (void)arg;
+
+    while (atomic_load(&remaining) > 0) {
+        pthread_mutex_lock(&locked.lock);
+        void *got = List_shift(locked.list);
+        pthread_mutex_unlock(&locked.lock);
+
+        if (got) {
+            atomic_fetch_sub(&remaining, 1);
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+// Runs pairs producer/consumer pairs moving n values in total.
+static double run_pairs(int pairs, int n, void *(*producer)(void *),
+        void *(*consumer)(void *))
+{
+    pthread_t threads[MAX_THREADS * 2];
+    double secs = 0;
+    int i = 0;
+
+    per_thread = n / pairs;
+    atomic_store(&remaining, per_thread * pairs);
+
+    BENCH(secs, {
+        for (i = 0; i < pairs; i++) {
+            pthread_create(&threads[i * 2], NULL, producer, NULL);
+            pthread_create(&threads[i * 2 + 1], NULL, consumer, NULL);
+        }
+        for (i = 0; i < pairs * 2; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    });
+
+    return secs;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = bench_max_n(argc, argv, 2000000);
+    int pairs = 0;
+    char name[64];
+
+    printf("----\nBENCH: CQueue vs mutex + List, producer/consumer pairs\n");
+
+    queue = CQueue_create();
+    locked.list = List_create();
+
+    for (pairs = 1; pairs <= MAX_THREADS; pairs *= 2) {
+        snprintf(name, sizeof(name), "mutex List %d+%d", pairs, pairs);
+        bench_report(name, n, run_pairs(pairs, n, locked_producer,
+                    locked_consumer));
+
+        snprintf(name, sizeof(name), "CQueue %d+%d", pairs, pairs);
+        bench_report(name, n, run_pairs(pairs, n, cqueue_producer,
+                    cqueue_consumer));
+    }
+
+    List_destroy(locked.list);
+    CQueue_destroy(queue);
+
+    return 0;
+}
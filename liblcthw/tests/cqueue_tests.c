@@ -0,0 +1,198 @@
+#include "minunit.h"
+#include <lcthw/cqueue.h>
+#include <stdint.h>
+#include <sched.h>
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define PER_PRODUCER 50000
+#define TOTAL (PRODUCERS * PER_PRODUCER)
+
+static CQueue *queue = NULL;
+static atomic_int consumed;
+static atomic_char seen[TOTAL];
+
+typedef struct Consumer {
+    pthread_t thread;
+    int out_of_order;
+} Consumer;
+
+// Values are 1 + producer * PER_PRODUCER + seq, so none are NULL.
+static void *produce(void *arg)
+{
+    intptr_t producer = (intptr_t)arg;
+    int seq = 0;
+
+    for (seq = 0; seq < PER_PRODUCER; seq++) {
+        CQueue_push(queue, (void *)(1 + producer * PER_PRODUCER + seq));
+    }
+
+    return NULL;
+}
+
+static void *consume(void *arg)
+{
+    Consumer *consumer = arg;
+    int last[PRODUCERS];
+    int i = 0;
+
+    for (i = 0; i < PRODUCERS; i++) {
+        last[i] = -1;
+    }
+
+    while (atomic_load(&consumed) < TOTAL) {
+        intptr_t value = (intptr_t)CQueue_shift(queue);
+        if (value == 0) {
+            sched_yield();
+            continue;
+        }
+
+        int id = value - 1;
+        int producer = id / PER_PRODUCER;
+        int seq = id % PER_PRODUCER;
+
+        // one consumer sees each producer's values in push order
+        if (seq <= last[producer]) {
+            consumer->out_of_order++;
+        }
+        last[producer] = seq;
+
+        atomic_fetch_add(&seen[id], 1);
+        atomic_fetch_add(&consumed, 1);
+    }
+
+    return NULL;
+}
+
+char *test_create()
+{
+    queue = CQueue_create();
+    mu_assert(queue != NULL, "Failed to create queue.");
+    mu_assert(CQueue_count(queue) == 0, "New queue isn't empty.");
+    mu_assert(CQueue_shift(queue) == NULL, "Shift of empty queue.");
+
+    return NULL;
+}
+
+char *test_push_shift()
+{
+    char *values[] = { "one", "two", "three" };
+    int i = 0;
+
+    for (i = 0; i < 3; i++) {
+        mu_assert(CQueue_push(queue, values[i]) == 0, "Push failed.");
+    }
+    mu_assert(CQueue_count(queue) == 3, "Wrong count on push.");
+
+    for (i = 0; i < 3; i++) {
+        mu_assert(CQueue_shift(queue) == values[i], "Wrong value on shift.");
+    }
+    mu_assert(CQueue_count(queue) == 0, "Wrong count after shift.");
+    mu_assert(CQueue_shift(queue) == NULL, "Shift of empty queue.");
+
+    // enough churn to retire and reclaim nodes
+    for (i = 0; i < 10000; i++) {
+        CQueue_push(queue, values[i % 3]);
+        mu_assert(CQueue_shift(queue) == values[i % 3], "Wrong value.");
+    }
+
+    return NULL;
+}
+
+char *test_stress()
+{
+    pthread_t producers[PRODUCERS];
+    Consumer consumers[CONSUMERS] = { { 0 } };
+    intptr_t i = 0;
+
+    atomic_init(&consumed, 0);
+
+    for (i = 0; i < CONSUMERS; i++) {
+        mu_assert(pthread_create(&consumers[i].thread, NULL, consume,
+                    &consumers[i]) == 0, "Failed to start consumer.");
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        mu_assert(pthread_create(&producers[i], NULL, produce,
+                    (void *)i) == 0, "Failed to start producer.");
+    }
+
+    for (i = 0; i < PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    for (i = 0; i < CONSUMERS; i++) {
+        pthread_join(consumers[i].thread, NULL);
+        mu_assert(consumers[i].out_of_order == 0,
+                "Consumer saw a producer's values out of order.");
+    }
+
+    for (i = 0; i < TOTAL; i++) {
+        mu_assert(atomic_load(&seen[i]) == 1,
+                "Value lost or delivered twice.");
+    }
+    mu_assert(CQueue_count(queue) == 0, "Queue should be drained.");
+    mu_assert(CQueue_shift(queue) == NULL, "Queue should be empty.");
+
+    return NULL;
+}
+
+static void *push_and_exit(void *arg)
+{
+    CQueue_push(arg, "from a thread");
+    return NULL;
+}
+
+char *test_many()
+{
+    CQueue *queues[2000] = { NULL };
+    int i = 0;
+
+    // more queues than a process has pthread keys
+    for (i = 0; i < 2000; i++) {
+        queues[i] = CQueue_create();
+        mu_assert(queues[i] != NULL, "Failed to create queue.");
+        mu_assert(CQueue_push(queues[i], "many") == 0, "Push failed.");
+    }
+    for (i = 0; i < 2000; i++) {
+        mu_assert(CQueue_shift(queues[i]) != NULL, "Wrong value.");
+        CQueue_destroy(queues[i]);
+    }
+
+    // an exiting thread hands its record back
+    CQueue *other = CQueue_create();
+    pthread_t thread;
+    mu_assert(pthread_create(&thread, NULL, push_and_exit, other) == 0,
+            "Failed to start thread.");
+    pthread_join(thread, NULL);
+    mu_assert(atomic_load(&atomic_load(&other->records)->active) == 0,
+            "Exited thread kept its record.");
+    mu_assert(CQueue_shift(other) != NULL, "Lost the thread's value.");
+    mu_assert(atomic_load(&other->record_count) == 1,
+            "Record of the exited thread should be reused.");
+    CQueue_destroy(other);
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    // destroy frees whatever is still queued
+    CQueue_push(queue, "left over");
+    CQueue_destroy(queue);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_shift);
+    mu_run_test(test_stress);
+    mu_run_test(test_many);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
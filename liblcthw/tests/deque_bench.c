@@ -0,0 +1,138 @@
+#include "bench.h"
+#include <lcthw/deque.h>
+#include <lcthw/list.h>
+
+// One container under test; every workload drives it through these.
+typedef struct QueueOps {
+    const char *name;
+    void *(*create) ();
+    void (*push) (void *queue, void *value);
+    void (*unshift) (void *queue, void *value);
+    void *(*pop) (void *queue);
+    void *(*shift) (void *queue);
+    void (*destroy) (void *queue);
+} QueueOps;
+
+// Adapts a type's push/pop/shift/unshift to the untyped QueueOps.
+#define QUEUE_WRAPPERS(T) \
+static void T##_push_any(void *q, void *v) { T##_push(q, v); }\
+static void T##_unshift_any(void *q, void *v) { T##_unshift(q, v); }\
+static void *T##_pop_any(void *q) { return T##_pop(q); }\
+static void *T##_shift_any(void *q) { return T##_shift(q); }\
+static void T##_destroy_any(void *q) { T##_destroy(q); }
+
+QUEUE_WRAPPERS(List)
+QUEUE_WRAPPERS(Deque)
+
+static void *list_create()
+{
+    return List_create();
+}
+
+static void *pooled_create()
+{
+    return List_create_pooled(NULL);
+}
+
+static void *deque_create()
+{
+    return Deque_create();
+}
+
+static const QueueOps queues[] = {
+    {"List", list_create, List_push_any, List_unshift_any, List_pop_any,
+        List_shift_any, List_destroy_any},
+    {"pooled List", pooled_create, List_push_any, List_unshift_any,
+        List_pop_any, List_shift_any, List_destroy_any},
+    {"Deque", deque_create, Deque_push_any, Deque_unshift_any,
+        Deque_pop_any, Deque_shift_any, Deque_destroy_any},
+};
+
+#define NUM_QUEUES (int)(sizeof(queues) / sizeof(queues[0]))
+
+static char *value = "bench";
+
+// Fill with n values, then drain them in order.
+static void fifo_burst(const QueueOps * ops, void *queue, int n)
+{
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        ops->push(queue, value);
+    }
+    for (i = 0; i < n; i++) {
+        ops->shift(queue);
+    }
+}
+
+// A work queue that stays about 1000 deep.
+static void fifo_steady(const QueueOps * ops, void *queue, int n)
+{
+    int i = 0;
+
+    for (i = 0; i < 1000; i++) {
+        ops->push(queue, value);
+    }
+    for (i = 0; i < n; i++) {
+        ops->push(queue, value);
+        ops->shift(queue);
+    }
+    for (i = 0; i < 1000; i++) {
+        ops->shift(queue);
+    }
+}
+
+// A stack used from the front.
+static void lifo(const QueueOps * ops, void *queue, int n)
+{
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        ops->unshift(queue, value);
+        if (i % 3 == 2) {
+            ops->shift(queue);
+        }
+    }
+    while (ops->pop(queue)) {
+    }
+}
+
+typedef struct Workload {
+    const char *name;
+    void (*run) (const QueueOps * ops, void *queue, int n);
+} Workload;
+
+static const Workload workloads[] = {
+    {"fifo burst", fifo_burst},
+    {"fifo steady", fifo_steady},
+    {"lifo", lifo},
+};
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 10000000);
+    int n = 0;
+    int w = 0;
+    int q = 0;
+    double secs = 0;
+    char name[64];
+
+    printf("----\nBENCH: queue workloads on List and Deque\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        for (w = 0; w < 3; w++) {
+            for (q = 0; q < NUM_QUEUES; q++) {
+                void *queue = queues[q].create();
+
+                BENCH(secs, workloads[w].run(&queues[q], queue, n));
+                snprintf(name, sizeof(name), "%s %s", workloads[w].name,
+                        queues[q].name);
+                bench_report(name, n, secs);
+
+                queues[q].destroy(queue);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "minunit.h"
+#include <lcthw/deque.h>
+#include <lcthw/list.h>
+#include <stdint.h>
+
+static Deque *deque = NULL;
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+char *test3 = "test3 data";
+
+char *test_create()
+{
+    deque = Deque_create();
+    mu_assert(deque != NULL, "Failed to create deque.");
+    mu_assert(Deque_count(deque) == 0, "New deque isn't empty.");
+    mu_assert(Deque_pop(deque) == NULL, "Pop of empty deque.");
+    mu_assert(Deque_shift(deque) == NULL, "Shift of empty deque.");
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    Deque_push(deque, test1);
+    Deque_push(deque, test2);
+    Deque_push(deque, test3);
+    mu_assert(Deque_last(deque) == test3, "Wrong last value.");
+    mu_assert(Deque_first(deque) == test1, "Wrong first value.");
+    mu_assert(Deque_count(deque) == 3, "Wrong count on push.");
+
+    mu_assert(Deque_pop(deque) == test3, "Wrong value on pop.");
+    mu_assert(Deque_pop(deque) == test2, "Wrong value on pop.");
+    mu_assert(Deque_pop(deque) == test1, "Wrong value on pop.");
+    mu_assert(Deque_count(deque) == 0, "Wrong count after pop.");
+
+    return NULL;
+}
+
+char *test_unshift_shift()
+{
+    Deque_unshift(deque, test1);
+    Deque_unshift(deque, test2);
+    Deque_unshift(deque, test3);
+    mu_assert(Deque_first(deque) == test3, "Wrong first value.");
+    mu_assert(Deque_last(deque) == test1, "Wrong last value.");
+
+    mu_assert(Deque_shift(deque) == test3, "Wrong value on shift.");
+    mu_assert(Deque_shift(deque) == test2, "Wrong value on shift.");
+    mu_assert(Deque_shift(deque) == test1, "Wrong value on shift.");
+    mu_assert(Deque_count(deque) == 0, "Wrong count after shift.");
+
+    return NULL;
+}
+
+char *test_grow_shrink()
+{
+    intptr_t i = 0;
+
+    // unshift first so the values wrap around the end of the buffer
+    for (i = 0; i < 1000; i++) {
+        Deque_unshift(deque, (void *)(i + 1));
+    }
+    mu_assert(deque->capacity == 1024, "Deque didn't grow by doubling.");
+    for (i = 0; i < 1000; i++) {
+        mu_assert(Deque_get(deque, i) == (void *)(1000 - i),
+                "Wrong value after growing.");
+    }
+
+    for (i = 0; i < 990; i++) {
+        Deque_pop(deque);
+    }
+    mu_assert(deque->capacity < 1024 / DEQUE_SHRINK_DIVISOR,
+            "Deque didn't shrink.");
+    mu_assert(deque->capacity >= DEQUE_MIN_CAPACITY, "Shrunk too far.");
+    for (i = 0; i < 10; i++) {
+        mu_assert(Deque_shift(deque) == (void *)(1000 - i),
+                "Wrong value after shrinking.");
+    }
+
+    return NULL;
+}
+
+// Runs the same random operations on a Deque and a List.
+char *test_against_list()
+{
+    List *list = List_create();
+    intptr_t i = 0;
+
+    srand(5);
+    for (i = 1; i < 100000; i++) {
+        int op = rand() % 4;
+        // drift up and down so the buffer grows and shrinks
+        if ((i / 20000) % 2 && op < 2) {
+            op += 2;
+        }
+
+        if (op == 0) {
+            Deque_push(deque, (void *)i);
+            List_push(list, (void *)i);
+        } else if (op == 1) {
+            Deque_unshift(deque, (void *)i);
+            List_unshift(list, (void *)i);
+        } else if (op == 2) {
+            mu_assert(Deque_pop(deque) == List_pop(list), "Pop differs.");
+        } else {
+            mu_assert(Deque_shift(deque) == List_shift(list),
+                    "Shift differs.");
+        }
+        mu_assert(Deque_count(deque) == List_count(list), "Count differs.");
+    }
+
+    i = 0;
+    LIST_FOREACH(list, first, next, cur) {
+        mu_assert(Deque_get(deque, i) == cur->value, "Contents differ.");
+        i++;
+    }
+
+    List_destroy(list);
+    while (Deque_count(deque) > 0) {
+        Deque_pop(deque);
+    }
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    Deque_push(deque, malloc(8));
+    Deque_clear_destroy(deque);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_unshift_shift);
+    mu_run_test(test_grow_shrink);
+    mu_run_test(test_against_list);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
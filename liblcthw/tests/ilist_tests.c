@@ -0,0 +1,134 @@
+#include "minunit.h"
+#include <lcthw/ilist.h>
+#include <assert.h>
+
+typedef struct Job {
+    int id;
+    IListLink run_link;
+    IListLink all_link;
+} Job;
+
+#define NUM_JOBS 6
+
+static IList *run_queue = NULL;
+static IList *all_jobs = NULL;
+static Job jobs[NUM_JOBS];
+
+char *test_create()
+{
+    int i = 0;
+    for (i = 0; i < NUM_JOBS; i++) {
+        jobs[i].id = i;
+    }
+
+    run_queue = IList_create();
+    all_jobs = IList_create();
+    mu_assert(run_queue != NULL && all_jobs != NULL,
+            "Failed to create list.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    IList_destroy(run_queue);
+    IList_destroy(all_jobs);
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    IList_push(run_queue, &jobs[0].run_link);
+    IList_push(run_queue, &jobs[1].run_link);
+    IList_push(run_queue, &jobs[2].run_link);
+    mu_assert(IList_count(run_queue) == 3, "Wrong count on push.");
+    mu_assert(IList_last(run_queue, Job, run_link) == &jobs[2],
+            "Wrong last record.");
+    mu_assert(IList_first(run_queue, Job, run_link) == &jobs[0],
+            "Wrong first record.");
+
+    Job *job = IList_entry(IList_pop(run_queue), Job, run_link);
+    mu_assert(job == &jobs[2], "Wrong record on pop.");
+    job = IList_entry(IList_shift(run_queue), Job, run_link);
+    mu_assert(job == &jobs[0], "Wrong record on shift.");
+    job = IList_entry(IList_pop(run_queue), Job, run_link);
+    mu_assert(job == &jobs[1], "Wrong record on pop.");
+
+    mu_assert(IList_count(run_queue) == 0, "Wrong count after pop.");
+    mu_assert(IList_pop(run_queue) == NULL, "Pop of empty list.");
+
+    return NULL;
+}
+
+char *test_two_lists()
+{
+    // one record, two links: each list threads its own member
+    int i = 0;
+    for (i = 0; i < NUM_JOBS; i++) {
+        IList_push(all_jobs, &jobs[i].all_link);
+        IList_unshift(run_queue, &jobs[i].run_link);
+    }
+
+    int expect = 0;
+    ILIST_FOREACH(all_jobs, first, next, Job, all_link, job) {
+        mu_assert(job->id == expect, "Wrong record walking all_jobs.");
+        expect++;
+    }
+    mu_assert(expect == NUM_JOBS, "Missed records in all_jobs.");
+
+    // like LIST_FOREACH, one walk per scope
+    {
+        expect = 0;
+        ILIST_FOREACH(run_queue, last, prev, Job, run_link, job) {
+            mu_assert(job->id == expect, "Wrong record walking run_queue.");
+            expect++;
+        }
+    }
+
+    IList_remove(run_queue, &jobs[3].run_link);
+    mu_assert(IList_count(run_queue) == NUM_JOBS - 1,
+            "Wrong count after remove.");
+    mu_assert(IList_count(all_jobs) == NUM_JOBS,
+            "Remove should not touch the other list.");
+
+    return NULL;
+}
+
+char *test_split_join()
+{
+    IList *tail = IList_split(all_jobs, 4);
+    mu_assert(IList_count(all_jobs) == 4, "Wrong count after split.");
+    mu_assert(IList_count(tail) == 2, "Wrong tail count after split.");
+    mu_assert(IList_first(tail, Job, all_link) == &jobs[4],
+            "Wrong first of tail.");
+    mu_assert(IList_last(all_jobs, Job, all_link) == &jobs[3],
+            "Wrong last after split.");
+
+    IList_join(all_jobs, tail);
+    mu_assert(IList_count(all_jobs) == NUM_JOBS, "Wrong count after join.");
+    mu_assert(IList_count(tail) == 0, "Joined list should be empty.");
+    IList_destroy(tail);
+
+    IList *all = IList_split(all_jobs, 0);
+    mu_assert(IList_count(all_jobs) == 0, "Split at 0 should move all.");
+    IList_join(all_jobs, all);
+    IList_destroy(all);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_two_lists);
+    mu_run_test(test_split_join);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,63 @@
+#include "bench.h"
+#include <lcthw/list.h>
+
+static char *value = "bench";
+
+static double bench_iterate(List * list)
+{
+    double secs = 0;
+    size_t sum = 0;
+
+    BENCH(secs, {
+        LIST_FOREACH(list, first, next, cur) {
+            sum += (size_t)cur->value;
+        }
+    });
+
+    // keeps the walk from being optimized away
+    if (sum == 1) {
+        printf("unlikely\n");
+    }
+
+    return secs;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 1000000);
+    int n = 0;
+    int i = 0;
+
+    printf("----\nBENCH: iteration over a churned list, before and after List_compact\n");
+
+    srand(1);
+    for (n = 1000; n <= max_n; n *= 10) {
+        List *list = List_create();
+        ListNode **nodes = malloc(n * sizeof(ListNode *));
+
+        for (i = 0; i < n; i++) {
+            List_push(list, value);
+            nodes[i] = list->last;
+        }
+        bench_report("fresh iterate", n, bench_iterate(list));
+
+        // random remove/push churn scatters nodes across the heap
+        for (i = 0; i < n * 2; i++) {
+            int victim = rand() % n;
+            List_remove(list, nodes[victim]);
+            List_push(list, value);
+            nodes[victim] = list->last;
+        }
+        bench_report("churned iterate", n, bench_iterate(list));
+
+        double secs = 0;
+        BENCH(secs, List_compact(list));
+        bench_report("compact", n, secs);
+        bench_report("compacted iterate", n, bench_iterate(list));
+
+        free(nodes);
+        List_destroy(list);
+    }
+
+    return 0;
+}
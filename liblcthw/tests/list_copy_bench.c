@@ -0,0 +1,69 @@
+#include "bench.h"
+#include <lcthw/list.h>
+#include <string.h>
+
+#define WORD_LEN 16
+
+static size_t copy_word(void *dst, const void *value)
+{
+    size_t len = strlen(value) + 1;
+    if (dst) {
+        memcpy(dst, value, len);
+    }
+    return len;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 10000000);
+    int n = 0;
+    int i = 0;
+    double secs = 0;
+
+    printf("----\nBENCH: snapshot by push loop vs List_copy\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        char *words = malloc((size_t)n * WORD_LEN);
+        List *source = List_create();
+
+        for (i = 0; i < n; i++) {
+            snprintf(&words[i * WORD_LEN], WORD_LEN, "word %d", i);
+            List_push(source, &words[i * WORD_LEN]);
+        }
+
+        List *copy = List_create();
+        BENCH(secs, {
+            LIST_FOREACH(source, first, next, cur) {
+                List_push(copy, cur->value);
+            }
+        });
+        bench_report("push loop copy", n, secs);
+        BENCH(secs, List_destroy(copy));
+        bench_report("push loop destroy", n, secs);
+
+        BENCH(secs, copy = List_copy(source));
+        bench_report("List_copy", n, secs);
+        BENCH(secs, List_destroy(copy));
+        bench_report("List_copy destroy", n, secs);
+
+        copy = List_create();
+        BENCH(secs, {
+            LIST_FOREACH(source, first, next, cur) {
+                List_push(copy, strdup(cur->value));
+            }
+        });
+        bench_report("push strdup copy", n, secs);
+        BENCH(secs, List_clear_destroy(copy));
+        bench_report("push strdup destroy", n, secs);
+
+        BENCH(secs, copy = List_deep_copy(source, copy_word));
+        bench_report("List_deep_copy", n, secs);
+        BENCH(secs, List_destroy(copy));
+        bench_report("List_deep_copy destroy", n, secs);
+
+        List_destroy(source);
+        free(words);
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "bench.h"
+#include <lcthw/list_index.h>
+
+#define NUM_LOOKUPS 1000
+
+static char *value = "bench";
+
+static double bench_get(List * list)
+{
+    double secs = 0;
+    size_t sum = 0;
+    int i = 0;
+
+    BENCH(secs, {
+        for (i = 0; i < NUM_LOOKUPS; i++) {
+            sum += (size_t)List_get(list, rand() % List_count(list));
+        }
+    });
+
+    if (sum == 1) {
+        printf("unlikely\n");
+    }
+
+    return secs;
+}
+
+// Splits off a random tail and joins it straight back.
+static double bench_split_join(List * list)
+{
+    double secs = 0;
+    int i = 0;
+
+    BENCH(secs, {
+        for (i = 0; i < NUM_LOOKUPS; i++) {
+            List *tail = List_split(list, 1 + rand() % (List_count(list) - 1));
+            List_join(list, tail);
+            List_destroy(tail);
+        }
+    });
+
+    return secs;
+}
+
+static double bench_push(List * list, int n)
+{
+    double secs = 0;
+    int i = 0;
+
+    BENCH(secs, {
+        for (i = 0; i < n; i++) {
+            List_push(list, value);
+        }
+    });
+
+    return secs;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 1000000);
+    int n = 0;
+
+    printf("----\nBENCH: positional access with and without a List_index\n");
+
+    srand(1);
+    for (n = 1000; n <= max_n; n *= 10) {
+        List *plain = List_create_pooled(NULL);
+        List *indexed = List_create_pooled(NULL);
+
+        List_index(indexed);
+        bench_report("plain push", n, bench_push(plain, n));
+        bench_report("indexed push", n, bench_push(indexed, n));
+
+        bench_report("plain get", NUM_LOOKUPS, bench_get(plain));
+        bench_report("indexed get", NUM_LOOKUPS, bench_get(indexed));
+
+        bench_report("plain split+join", NUM_LOOKUPS,
+                bench_split_join(plain));
+        bench_report("indexed split+join", NUM_LOOKUPS,
+                bench_split_join(indexed));
+
+        List_destroy(plain);
+        List_destroy(indexed);
+    }
+
+    return 0;
+}
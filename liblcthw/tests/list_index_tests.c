@@ -0,0 +1,287 @@
+#include "minunit.h"
+#include <lcthw/list_index.h>
+#include <stdint.h>
+
+#define MAX_ITEMS 2000
+#define NUM_OPS 20000
+
+static List *list = NULL;
+static intptr_t model[MAX_ITEMS];
+static int model_count = 0;
+static int next_value = 1;
+
+static int rank_of(List * l, ListNode * node)
+{
+    int rank = 0;
+
+    LIST_FOREACH(l, first, next, cur) {
+        if (cur == node) {
+            return rank;
+        }
+        rank++;
+    }
+
+    return -1;
+}
+
+static ListTower *map_lookup(List * l, ListNode * node)
+{
+    ListTowerMap *map = l->index->map;
+    int i = 0;
+
+    for (i = 0; i < map->capacity; i++) {
+        if (map->keys[i] == node) {
+            return map->towers[i];
+        }
+    }
+
+    return NULL;
+}
+
+// Walks every level and checks each span against the real distance.
+static char *check_index(List * l)
+{
+    ListTower *head = l->index->head;
+    int level = 0;
+
+    for (level = 0; level < LIST_INDEX_MAX_LEVEL; level++) {
+        ListTower *tower = head;
+        int pos = -1;
+
+        while (tower->links[level].next) {
+            ListTower *next = tower->links[level].next;
+            int next_pos = rank_of(l, next->node);
+
+            mu_assert(next_pos > pos, "Tower out of order.");
+            mu_assert(next->links[level].prev == tower, "Bad prev link.");
+            mu_assert(tower->links[level].span == next_pos - pos,
+                    "Wrong span.");
+            mu_assert(map_lookup(l, next->node) == next,
+                    "Tower missing from map.");
+
+            tower = next;
+            pos = next_pos;
+        }
+
+        mu_assert(tower->links[level].span == List_count(l) - pos,
+                "Wrong span to the tail.");
+    }
+
+    return NULL;
+}
+
+static char *check_model()
+{
+    int i = 0;
+
+    mu_assert(List_count(list) == model_count, "Wrong count.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        mu_assert((intptr_t)cur->value == model[i], "List differs.");
+        i++;
+    }
+
+    for (i = 0; i < model_count; i += 7) {
+        mu_assert((intptr_t)List_get(list, i) == model[i],
+                "Wrong value from List_get.");
+    }
+
+    return check_index(list);
+}
+
+static void model_insert(int at, intptr_t value)
+{
+    memmove(&model[at + 1], &model[at],
+            (model_count - at) * sizeof(intptr_t));
+    model[at] = value;
+    model_count++;
+}
+
+static void model_remove(int at)
+{
+    memmove(&model[at], &model[at + 1],
+            (model_count - at - 1) * sizeof(intptr_t));
+    model_count--;
+}
+
+char *test_index()
+{
+    int i = 0;
+
+    list = List_create_pooled(NULL);
+    for (i = 0; i < 500; i++) {
+        List_push(list, (void *)(intptr_t)next_value);
+        model[model_count++] = next_value++;
+    }
+
+    mu_assert(List_index(list) == 0, "Failed to index list.");
+    mu_assert(list->index != NULL, "No index.");
+
+    return check_model();
+}
+
+char *test_random_ops()
+{
+    int i = 0;
+    srand(12345);
+
+    for (i = 0; i < NUM_OPS; i++) {
+        int op = rand() % 7;
+        intptr_t value = next_value++;
+
+        if (model_count >= MAX_ITEMS - 1) {
+            op = 3;
+        } else if (model_count == 0) {
+            op = 0;
+        }
+
+        if (op == 0) {
+            List_push(list, (void *)value);
+            model[model_count++] = value;
+        } else if (op == 1) {
+            List_unshift(list, (void *)value);
+            model_insert(0, value);
+        } else if (op == 2) {
+            int at = rand() % (model_count + 1);
+            mu_assert(List_insert(list, at, (void *)value) == 0,
+                    "Insert failed.");
+            model_insert(at, value);
+        } else if (op == 3) {
+            int at = rand() % model_count;
+            void *got = List_remove(list, List_node_at(list, at));
+            mu_assert((intptr_t)got == model[at], "Removed wrong node.");
+            model_remove(at);
+        } else if (op == 4) {
+            mu_assert((intptr_t)List_pop(list) == model[model_count - 1],
+                    "Wrong value on pop.");
+            model_count--;
+        } else if (op == 5) {
+            mu_assert((intptr_t)List_shift(list) == model[0],
+                    "Wrong value on shift.");
+            model_remove(0);
+        } else {
+            int at = rand() % model_count;
+            intptr_t moved = model[at];
+            List_move_first(list, List_node_at(list, at));
+            model_remove(at);
+            model_insert(0, moved);
+        }
+
+        if (i % 1000 == 0) {
+            char *message = check_model();
+            if (message) {
+                return message;
+            }
+        }
+    }
+
+    return check_model();
+}
+
+char *test_split_join()
+{
+    int i = 0;
+
+    for (i = 0; i < 50; i++) {
+        int at = 1 + rand() % (model_count - 1);
+        List *tail = List_split(list, at);
+        mu_assert(tail != NULL, "Split failed.");
+        mu_assert(tail->index != NULL, "Split off list is not indexed.");
+        mu_assert(List_count(list) == at, "Wrong count after split.");
+        mu_assert((intptr_t)List_get(tail, 0) == model[at],
+                "Wrong first value after split.");
+
+        char *message = check_index(list);
+        if (message == NULL) {
+            message = check_index(tail);
+        }
+        if (message) {
+            return message;
+        }
+
+        // both halves keep working on their own
+        intptr_t value = next_value++;
+        List_insert(tail, 1, (void *)value);
+        model_insert(at + 1, value);
+        List_remove(list, List_node_at(list, 0));
+        model_remove(0);
+
+        List_join(list, tail);
+        mu_assert(tail->index == NULL, "Joined index was not taken over.");
+        List_destroy(tail);
+
+        message = check_model();
+        if (message) {
+            return message;
+        }
+    }
+
+    return NULL;
+}
+
+char *test_unindexed()
+{
+    List *other = List_create_pooled(list->pool);
+    int i = 0;
+
+    for (i = 0; i < 10; i++) {
+        List_push(other, (void *)(intptr_t)next_value);
+        model[model_count++] = next_value++;
+    }
+
+    mu_assert((intptr_t)List_get(other, 9) == model[model_count - 1],
+            "Walking List_get failed.");
+
+    // joining a plain list rebuilds the index over both
+    List_join(list, other);
+    List_destroy(other);
+
+    return check_model();
+}
+
+char *test_bulk()
+{
+    void *values[100];
+    int i = 0;
+
+    for (i = 0; i < 100; i++) {
+        values[i] = (void *)(intptr_t)next_value;
+        model[model_count++] = next_value++;
+    }
+
+    mu_assert(List_push_many(list, values, 100) == 0, "push_many failed.");
+    char *message = check_model();
+    if (message) {
+        return message;
+    }
+
+    mu_assert(List_compact(list) == 0, "Compact failed.");
+    message = check_model();
+    if (message) {
+        return message;
+    }
+
+    List_unindex(list);
+    mu_assert(list->index == NULL, "Unindex failed.");
+    mu_assert((intptr_t)List_get(list, model_count / 2)
+            == model[model_count / 2], "Wrong value without index.");
+
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_index);
+    mu_run_test(test_random_ops);
+    mu_run_test(test_split_join);
+    mu_run_test(test_unindexed);
+    mu_run_test(test_bulk);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,47 @@
+#include "bench.h"
+#include <lcthw/list.h>
+#include <lcthw/list_pool.h>
+
+static char *value = "bench";
+
+// queue workload: fill to n, then n rounds of push one/shift one, then drain
+static double bench_queue(List * list, int n)
+{
+    double secs = 0;
+    int i = 0;
+
+    BENCH(secs, {
+        for (i = 0; i < n; i++) {
+            List_push(list, value);
+        }
+        for (i = 0; i < n; i++) {
+            List_push(list, value);
+            List_shift(list);
+        }
+        for (i = 0; i < n; i++) {
+            List_shift(list);
+        }
+    });
+
+    return secs;
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 1000000);
+    int n = 0;
+
+    printf("----\nBENCH: list push/shift, calloc vs pooled nodes\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        List *plain = List_create();
+        bench_report("calloc push/shift", n * 3, bench_queue(plain, n));
+        List_destroy(plain);
+
+        List *pooled = List_create_pooled(NULL);
+        bench_report("pooled push/shift", n * 3, bench_queue(pooled, n));
+        List_destroy(pooled);
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "minunit.h"
+#include <lcthw/list.h>
+#include <lcthw/list_pool.h>
+#include <assert.h>
+
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+char *test3 = "test3 data";
+
+char *test_pool_alloc_free()
+{
+    ListPool *pool = ListPool_create(4);
+    mu_assert(pool != NULL, "Failed to create pool.");
+
+    ListNode *a = ListPool_alloc(pool);
+    mu_assert(a != NULL, "Failed to alloc node.");
+    mu_assert(pool->slabs != NULL, "Pool should have a slab.");
+    mu_assert(pool->free_count == 3, "Wrong free count after alloc.");
+    mu_assert(a->next == NULL && a->prev == NULL && a->value == NULL,
+            "Node from pool should be cleared.");
+
+    ListNode *b = ListPool_alloc(pool);
+    mu_assert(b == a + 1, "Nodes should come from one contiguous slab.");
+
+    ListPool_free(pool, a);
+    mu_assert(ListPool_alloc(pool) == a, "Freed node should be reused.");
+
+    int i = 0;
+    for (i = 0; i < 10; i++) {
+        mu_assert(ListPool_alloc(pool) != NULL, "Failed to grow pool.");
+    }
+    mu_assert(pool->slabs->next != NULL, "Pool should have grown a slab.");
+
+    ListPool_release(pool);
+
+    return NULL;
+}
+
+char *test_pooled_list()
+{
+    List *list = List_create_pooled(NULL);
+    mu_assert(list != NULL, "Failed to create pooled list.");
+    mu_assert(list->pool != NULL, "Pooled list has no pool.");
+
+    List_push(list, test1);
+    List_push(list, test2);
+    List_unshift(list, test3);
+    mu_assert(List_count(list) == 3, "Wrong count on push.");
+    mu_assert(List_first(list) == test3, "Wrong first value.");
+    mu_assert(List_last(list) == test2, "Wrong last value.");
+
+    mu_assert(List_shift(list) == test3, "Wrong value on shift.");
+    mu_assert(List_pop(list) == test2, "Wrong value on pop.");
+    mu_assert(list->pool->free_count == LIST_POOL_DEFAULT_SLAB - 1,
+            "Removed nodes should go back to the pool.");
+
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *test_shared_pool()
+{
+    ListPool *pool = ListPool_create(8);
+    List *a = List_create_pooled(pool);
+    List *b = List_create_pooled(pool);
+    mu_assert(pool->refcount == 3, "Lists should retain the pool.");
+
+    List_push(a, test1);
+    List_push(a, test2);
+    List_push(b, test3);
+
+    List_destroy(a);
+    mu_assert(pool->refcount == 2, "Destroy should release the pool.");
+    mu_assert(pool->free_count == 7, "Nodes of a should be back in pool.");
+
+    List_push(b, test1);
+    List *c = List_split(b, 1);
+    mu_assert(c->pool == pool, "Split list should share the pool.");
+    mu_assert(List_count(c) == 1, "Wrong count after split.");
+
+    List_destroy(c);
+    List_destroy(b);
+    mu_assert(pool->refcount == 1, "Only our reference should remain.");
+    ListPool_release(pool);
+
+    return NULL;
+}
+
+char *test_join_mismatch()
+{
+    List *plain = List_create();
+    List *pooled = List_create_pooled(NULL);
+
+    List_push(plain, test1);
+    List_push(pooled, test2);
+
+    List_join(plain, pooled);
+    mu_assert(List_count(plain) == 1,
+            "Join across different pools should be refused.");
+
+    List_destroy(plain);
+    List_destroy(pooled);
+
+    return NULL;
+}
+
+char *test_clear_destroy()
+{
+    List *list = List_create_pooled(NULL);
+    int i = 0;
+
+    for (i = 0; i < 200; i++) {
+        int *val = malloc(sizeof(int));
+        *val = i;
+        List_push(list, val);
+    }
+
+    mu_assert(List_count(list) == 200, "Wrong count on push.");
+    List_clear_destroy(list);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_pool_alloc_free);
+    mu_run_test(test_pooled_list);
+    mu_run_test(test_shared_pool);
+    mu_run_test(test_join_mismatch);
+    mu_run_test(test_clear_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -1,6 +1,9 @@
 #include "minunit.h"
 #include <lcthw/list.h>
+#include <lcthw/list_pool.h>
 #include <assert.h>
+#include <string.h>
+#include <stddef.h>
 
 static List *list = NULL;
 static List *another_list = NULL;
@@ -135,6 +138,354 @@ char *test_split()
     return NULL;
 }
 
+typedef struct Point {
+    int x;
+    int y;
+    char tag[8];
+} Point;
+
+char *test_inline()
+{
+    List *points = List_create_inline(sizeof(Point));
+    mu_assert(points != NULL, "Failed to create inline list.");
+
+    Point p = {.x = 1, .y = 2, .tag = "one" };
+    List_push(points, &p);
+    p.x = 3;
+    mu_assert(((Point *)List_last(points))->x == 1,
+            "Push should copy the value into the node.");
+    mu_assert(List_last(points) > (void *)points->last &&
+            (char *)List_last(points) - (char *)points->last
+            < (ptrdiff_t)(sizeof(ListNode) + _Alignof(max_align_t)),
+            "Value should live right after the node links.");
+
+    Point *q = List_push_new(points);
+    mu_assert(q != NULL && q->x == 0 && q->y == 0,
+            "New element should be zeroed.");
+    q->x = 5;
+
+    q = List_unshift_new(points);
+    q->x = 7;
+    mu_assert(List_count(points) == 3, "Wrong count on inline push.");
+
+    int expect[] = { 7, 1, 5 };
+    int i = 0;
+    LIST_FOREACH(points, first, next, cur) {
+        mu_assert(((Point *)cur->value)->x == expect[i],
+                "Wrong value walking inline list.");
+        i++;
+    }
+
+    List *tail = List_split(points, 2);
+    mu_assert(tail->element_size == sizeof(Point),
+            "Split should keep the inline element size.");
+    List_join(points, tail);
+    mu_assert(List_count(tail) == 0, "Joined list should be empty.");
+    List_destroy(tail);
+
+    Point out = { 0 };
+    mu_assert(List_shift_into(points, &out) == 0, "Shift into failed.");
+    mu_assert(out.x == 7, "Wrong value on shift into.");
+    mu_assert(List_pop_into(points, &out) == 0, "Pop into failed.");
+    mu_assert(out.x == 5, "Wrong value on pop into.");
+
+    mu_assert(List_pop(points) == NULL,
+            "Pop of an inline list can't hand out freed storage.");
+    mu_assert(List_pop_into(points, &out) == -1,
+            "Pop into an empty list should fail.");
+
+    List_clear_destroy(points);
+
+    return NULL;
+}
+
+// The payload needs more than the pointer alignment of the links.
+typedef struct Wide {
+    char tag;
+    max_align_t wide;
+} Wide;
+
+char *test_inline_align()
+{
+    List *wides = List_create_inline(sizeof(Wide));
+    Wide w = {.tag = 'w' };
+    int i = 0;
+
+    for (i = 0; i < 4; i++) {
+        List_push(wides, &w);
+        List_unshift_new(wides);
+    }
+
+    LIST_FOREACH(wides, first, next, cur) {
+        mu_assert((size_t)cur->value % _Alignof(Wide) == 0,
+                "Inline value isn't aligned for its type.");
+    }
+    mu_assert(((Wide *)List_last(wides))->tag == 'w',
+            "Wrong value in an aligned inline node.");
+
+    List_destroy(wides);
+
+    return NULL;
+}
+
+char *test_bulk()
+{
+    char *batch[] = { test1, test2, test3, test4, test5, test6 };
+    void *out[6] = { NULL };
+    int i = 0;
+
+    List *pooled = List_from_array((void **)batch, 3);
+    mu_assert(pooled != NULL, "Failed to build list from array.");
+    mu_assert(pooled->pool != NULL, "List_from_array should be pooled.");
+    mu_assert(List_count(pooled) == 3, "Wrong count from array.");
+    mu_assert(pooled->first + 2 == pooled->last,
+            "Nodes from an array should be contiguous.");
+
+    mu_assert(List_push_many(pooled, (void **)&batch[3], 3) == 0,
+            "Push many failed.");
+    mu_assert(List_count(pooled) == 6, "Wrong count after push many.");
+    mu_assert(List_to_array(pooled, out) == 6, "Wrong count to array.");
+    for (i = 0; i < 6; i++) {
+        mu_assert(out[i] == batch[i], "Wrong value exported.");
+    }
+    mu_assert(pooled->last->prev->prev->next->next == pooled->last,
+            "Spliced nodes are not linked both ways.");
+
+    // removing from a block hands the node back to the pool
+    List_remove(pooled, pooled->first->next);
+    mu_assert(List_count(pooled) == 5, "Wrong count after remove.");
+    List_destroy(pooled);
+
+    // a queue loaded in batches reuses the nodes it shifted off
+    void *load[100] = { NULL };
+    List *queue = List_create_pooled(NULL);
+    int round = 0;
+    for (round = 0; round < 1000; round++) {
+        mu_assert(List_push_many(queue, load, 100) == 0,
+                "Batch push failed.");
+        for (i = 0; i < 100; i++) {
+            List_shift(queue);
+        }
+    }
+    mu_assert(List_count(queue) == 0, "Queue should be drained.");
+    mu_assert(queue->pool->slabs->next == NULL &&
+            queue->pool->free_count == 100,
+            "Batch pushes should reuse freed nodes.");
+    List_destroy(queue);
+
+    List *plain = List_create();
+    mu_assert(List_push_many(plain, (void **)batch, 0) == 0,
+            "Push of nothing should succeed.");
+    List_push(plain, test1);
+    mu_assert(List_push_many(plain, (void **)&batch[1], 5) == 0,
+            "Push many onto a plain list failed.");
+    mu_assert(plain->pool == NULL, "Plain list should stay unpooled.");
+    mu_assert(List_to_array(plain, out) == 6, "Wrong count to array.");
+    for (i = 0; i < 6; i++) {
+        mu_assert(out[i] == batch[i], "Wrong value after plain push many.");
+    }
+    List_destroy(plain);
+
+    return NULL;
+}
+
+static char *check_compacted(List * list, void **expect, int n)
+{
+    int i = 0;
+
+    mu_assert(List_compact(list) == 0, "Compact failed.");
+    mu_assert(List_count(list) == n, "Compact changed the count.");
+    mu_assert(list->pool != NULL, "Compacted list should be pooled.");
+    mu_assert(list->last == list->first + (n - 1),
+            "Compacted nodes should be contiguous.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        mu_assert(cur->value == expect[i], "Compact changed the order.");
+        mu_assert(cur->prev == (i > 0 ? cur - 1 : NULL),
+                "Compact broke a prev link.");
+        i++;
+    }
+
+    return NULL;
+}
+
+char *test_compact()
+{
+    char *batch[] = { test1, test2, test3, test4, test5, test6 };
+    char *msg = NULL;
+    int i = 0;
+
+    // plain list scattered by removes and pushes
+    List *plain = List_create();
+    for (i = 0; i < 6; i++) {
+        List_unshift(plain, batch[5 - i]);
+    }
+    List_remove(plain, plain->first->next);
+    List_push(plain, test2);
+    void *expect[] = { test1, test3, test4, test5, test6, test2 };
+
+    msg = check_compacted(plain, expect, 6);
+    if (msg) return msg;
+
+    // compacting again reuses the private pool and drops its old slab
+    ListPool *pool = plain->pool;
+    msg = check_compacted(plain, expect, 6);
+    if (msg) return msg;
+    mu_assert(plain->pool == pool, "Private pool should be kept.");
+    mu_assert(pool->slabs->next == NULL, "Old slabs should be freed.");
+
+    // nodes still come and go one at a time afterwards
+    List_remove(plain, plain->first->next);
+    List_push(plain, test3);
+    mu_assert(List_count(plain) == 6, "Wrong count after compact churn.");
+
+    // a private pool stays one slab however often it is compacted
+    for (i = 0; i < 10; i++) {
+        List_push(plain, test4);
+        List_remove(plain, plain->first);
+        mu_assert(List_compact(plain) == 0, "Repeated compact failed.");
+    }
+    mu_assert(plain->pool->slabs->next == NULL &&
+            plain->pool->slabs->count == 6,
+            "Repeated compaction grew the pool.");
+    List_destroy(plain);
+
+    // a shared pool can't drop its old slabs, so it is refused rather
+    // than grown by count nodes on every call
+    ListPool *shared = ListPool_create(4);
+    List *a = List_create_pooled(shared);
+    List *b = List_create_pooled(shared);
+    List_push_many(a, (void **)batch, 6);
+    List_push(b, test1);
+
+    int slabs = 0;
+    ListSlab *slab = NULL;
+    for (slab = shared->slabs; slab != NULL; slab = slab->next) {
+        slabs++;
+    }
+    int free_count = shared->free_count;
+    for (i = 0; i < 10; i++) {
+        mu_assert(List_compact(a) == -1,
+                "Shared pool lists can't be compacted.");
+    }
+    for (slab = shared->slabs; slab != NULL; slab = slab->next) {
+        slabs--;
+    }
+    mu_assert(slabs == 0 && shared->free_count == free_count,
+            "Refused compaction changed the shared pool.");
+    i = 0;
+    {
+        LIST_FOREACH(a, first, next, cur) {
+            mu_assert(cur->value == batch[i], "Refused compact broke a.");
+            i++;
+        }
+    }
+
+    List *empty = List_create();
+    mu_assert(List_compact(empty) == 0, "Compacting nothing should work.");
+    List_destroy(empty);
+
+    List *inline_list = List_create_inline(sizeof(int));
+    mu_assert(List_compact(inline_list) == -1,
+            "Inline lists can't be compacted.");
+    List_destroy(inline_list);
+
+    List_destroy(a);
+    List_destroy(b);
+    ListPool_release(shared);
+
+    return NULL;
+}
+
+static size_t copy_string(void *dst, const void *value)
+{
+    size_t len = strlen(value) + 1;
+    if (dst) {
+        memcpy(dst, value, len);
+    }
+    return len;
+}
+
+// Sizes the six test values honestly once, then asks for more room
+// than the whole block has.
+static size_t copy_growing(void *dst, const void *value)
+{
+    static int probes = 0;
+    size_t len = copy_string(dst, value);
+    return dst || probes++ < 6 ? len : len + 4096;
+}
+
+char *test_copy()
+{
+    char *batch[] = { test1, test2, test3, test4, test5, test6 };
+    int i = 0;
+
+    List *source = List_create();
+    for (i = 0; i < 6; i++) {
+        List_push(source, batch[i]);
+    }
+
+    List *copy = List_copy(source);
+    mu_assert(copy != NULL && List_count(copy) == 6, "Wrong copy count.");
+    mu_assert(copy->pool && copy->pool->slabs->next == NULL,
+            "Copy should be one block.");
+    i = 0;
+    LIST_FOREACH(copy, first, next, cur) {
+        mu_assert(cur->value == batch[i], "Copy should share values.");
+        mu_assert(cur == &copy->first[i], "Copy nodes aren't contiguous.");
+        i++;
+    }
+    mu_assert(copy->last->prev->value == test5, "Copy prev links wrong.");
+
+    List *deep = List_deep_copy(source, copy_string);
+    mu_assert(deep != NULL && List_count(deep) == 6, "Wrong deep count.");
+    i = 0;
+    {
+        LIST_FOREACH(deep, first, next, cur) {
+            mu_assert(cur->value != batch[i], "Deep copy shares a value.");
+            mu_assert(strcmp(cur->value, batch[i]) == 0,
+                    "Deep copy differs.");
+            mu_assert(((size_t)cur->value % _Alignof(max_align_t)) == 0,
+                    "Deep copy value isn't aligned.");
+            i++;
+        }
+    }
+
+    // changing the copies leaves the source alone
+    List_pop(copy);
+    List_shift(deep);
+    List_push(deep, test1);
+    mu_assert(List_count(source) == 6 && List_last(source) == test6,
+            "Source changed with its copy.");
+
+    // the values share the block, so it can't be compacted away
+    mu_assert(List_compact(deep) == -1, "Compacted a deep copy.");
+    mu_assert(strcmp(deep->first->value, test2) == 0,
+            "Refused compact dropped deep copy values.");
+
+    // a copy that wants more than it sized for fails before writing
+    mu_assert(List_deep_copy(source, copy_growing) == NULL,
+            "Deep copy should refuse a copy that outgrows its size.");
+
+    List *empty = List_create();
+    List *empty_copy = List_deep_copy(empty, copy_string);
+    mu_assert(empty_copy && List_count(empty_copy) == 0,
+            "Copy of empty list.");
+
+    List *inline_list = List_create_inline(sizeof(int));
+    mu_assert(List_copy(inline_list) == NULL,
+            "Inline lists can't be copied.");
+
+    List_destroy(inline_list);
+    List_destroy(empty_copy);
+    List_destroy(empty);
+    List_destroy(deep);
+    List_destroy(copy);
+    List_destroy(source);
+
+    return NULL;
+}
+
 char *all_tests()
 {
     mu_suite_start();
@@ -147,6 +498,11 @@ char *all_tests()
     mu_run_test(test_remove);
     mu_run_test(test_shift);
     mu_run_test(test_destroy);
+    mu_run_test(test_inline);
+    mu_run_test(test_inline_align);
+    mu_run_test(test_bulk);
+    mu_run_test(test_compact);
+    mu_run_test(test_copy);
 
     return NULL;
 }
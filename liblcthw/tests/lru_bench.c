@@ -0,0 +1,114 @@
+#include "bench.h"
+#include <lcthw/lru.h>
+#include <stdint.h>
+
+#define NUM_OPS 2000000
+
+static uint32_t int_hash(const void *key)
+{
+    uint32_t h = (uint32_t)(uintptr_t)key;
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return h;
+}
+
+static int int_compare(const void *a, const void *b)
+{
+    return (uintptr_t)a != (uintptr_t)b;
+}
+
+// The hand-rolled version: a List scanned front to back.
+static void *scan_get(List * list, void *key)
+{
+    LIST_FOREACH(list, first, next, cur) {
+        if (cur->value == key) {
+            List_move_first(list, cur);
+            return key;
+        }
+    }
+
+    return NULL;
+}
+
+static void scan_put(List * list, int capacity, void *key)
+{
+    if (List_count(list) == capacity) {
+        List_pop(list);
+    }
+    List_unshift(list, key);
+}
+
+// Uniform keys over capacity / rate distinct values hit about rate of
+// the time once the cache is warm. Misses are followed by a put.
+static void bench_rate(int capacity, double rate, int ops, int scan)
+{
+    int universe = (int)(capacity / rate);
+    double secs = 0;
+    int i = 0;
+    char name[64];
+
+    srand(1);
+
+    if (scan) {
+        List *list = List_create_pooled(NULL);
+        int hits = 0;
+
+        BENCH(secs, {
+            for (i = 0; i < ops; i++) {
+                void *key = (void *)(uintptr_t)(1 + rand() % universe);
+                if (scan_get(list, key)) {
+                    hits++;
+                } else {
+                    scan_put(list, capacity, key);
+                }
+            }
+        });
+
+        snprintf(name, sizeof(name), "List scan %d %.0f%% (%.0f%%)",
+                capacity, rate * 100, hits * 100.0 / ops);
+        bench_report(name, ops, secs);
+        List_destroy(list);
+        return;
+    }
+
+    LRU *lru = LRU_create(capacity, int_compare, int_hash, NULL, NULL);
+
+    BENCH(secs, {
+        for (i = 0; i < ops; i++) {
+            void *key = (void *)(uintptr_t)(1 + rand() % universe);
+            if (LRU_get(lru, key) == NULL) {
+                LRU_put(lru, key, key);
+            }
+        }
+    });
+
+    snprintf(name, sizeof(name), "LRU %d %.0f%% (%.0f%%)", capacity,
+            rate * 100, LRU_hits(lru) * 100.0 / ops);
+    bench_report(name, ops, secs);
+    LRU_destroy(lru);
+}
+
+int main(int argc, char *argv[])
+{
+    int ops = bench_max_n(argc, argv, NUM_OPS);
+    double rates[] = { 0.5, 0.9, 0.99 };
+    int capacities[] = { 1000, 100000 };
+    int r = 0;
+    int c = 0;
+
+    printf("----\nBENCH: LRU get/put at target (measured) hit rates\n");
+
+    for (c = 0; c < 2; c++) {
+        for (r = 0; r < 3; r++) {
+            bench_rate(capacities[c], rates[r], ops, 0);
+        }
+    }
+
+    // the scan is O(capacity) a lookup, so keep it small
+    for (r = 0; r < 3; r++) {
+        bench_rate(1000, rates[r], ops / 100, 1);
+    }
+
+    return 0;
+}
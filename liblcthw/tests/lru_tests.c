@@ -0,0 +1,167 @@
+#include "minunit.h"
+#include <lcthw/lru.h>
+
+#define CAPACITY 3
+
+static LRU *lru = NULL;
+static char *evicted_key = NULL;
+static char *evicted_value = NULL;
+static int evict_calls = 0;
+
+static void record_evict(void *key, void *value, void *data)
+{
+    evicted_key = key;
+    evicted_value = value;
+    (*(int *)data)++;
+}
+
+char *test_create()
+{
+    lru = LRU_create(CAPACITY, NULL, NULL, record_evict, &evict_calls);
+    mu_assert(lru != NULL, "Failed to create LRU.");
+    mu_assert(LRU_count(lru) == 0, "New LRU isn't empty.");
+    mu_assert(LRU_create(0, NULL, NULL, NULL, NULL) == NULL,
+            "Zero capacity should fail.");
+
+    return NULL;
+}
+
+char *test_get_put()
+{
+    mu_assert(LRU_put(lru, "a", "apple") == 0, "Put failed.");
+    mu_assert(LRU_put(lru, "b", "banana") == 0, "Put failed.");
+    mu_assert(LRU_put(lru, "c", "cherry") == 0, "Put failed.");
+    mu_assert(LRU_count(lru) == 3, "Wrong count.");
+
+    // keys are compared by content, not pointer
+    char key[] = "a";
+    mu_assert(strcmp(LRU_get(lru, key), "apple") == 0, "Wrong value.");
+    mu_assert(LRU_get(lru, "z") == NULL, "Missing key found.");
+    mu_assert(LRU_hits(lru) == 1 && LRU_misses(lru) == 1,
+            "Wrong hit/miss counts.");
+
+    // "a" was just used, so "b" is the least recent
+    mu_assert(LRU_put(lru, "d", "date") == 0, "Put failed.");
+    mu_assert(evict_calls == 1, "Evict callback not called.");
+    mu_assert(strcmp(evicted_key, "b") == 0
+            && strcmp(evicted_value, "banana") == 0, "Evicted wrong pair.");
+    mu_assert(LRU_get(lru, "b") == NULL, "Evicted key still cached.");
+    mu_assert(LRU_count(lru) == CAPACITY, "Count over capacity.");
+    mu_assert(LRU_evictions(lru) == 1, "Wrong eviction count.");
+
+    // replacing hands the old pair to the callback
+    mu_assert(LRU_put(lru, "c", "coconut") == 0, "Replace failed.");
+    mu_assert(evict_calls == 2 && strcmp(evicted_value, "cherry") == 0,
+            "Replaced value not handed to evict.");
+    mu_assert(strcmp(LRU_get(lru, "c"), "coconut") == 0,
+            "Replace didn't stick.");
+    mu_assert(LRU_count(lru) == CAPACITY, "Replace changed the count.");
+
+    mu_assert(LRU_delete(lru, "a") == 0, "Delete failed.");
+    mu_assert(LRU_delete(lru, "a") == -1, "Deleted twice.");
+    mu_assert(LRU_get(lru, "a") == NULL, "Deleted key still cached.");
+    mu_assert(LRU_count(lru) == CAPACITY - 1, "Wrong count after delete.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    int before = evict_calls;
+    LRU_destroy(lru);
+    mu_assert(evict_calls == before + 2, "Destroy didn't evict the rest.");
+
+    return NULL;
+}
+
+#define CHURN_CAPACITY 64
+#define CHURN_KEYS 200
+#define CHURN_OPS 100000
+
+static uint32_t int_hash(const void *key)
+{
+    // a poor hash keeps the probe chains long
+    return (uint32_t)(uintptr_t)key % 37;
+}
+
+static int int_compare(const void *a, const void *b)
+{
+    return (uintptr_t)a != (uintptr_t)b;
+}
+
+// Checks the cache against a plain array kept in recency order.
+char *test_churn()
+{
+    uintptr_t model[CHURN_CAPACITY];
+    int model_count = 0;
+    int i = 0;
+    int j = 0;
+
+    lru = LRU_create(CHURN_CAPACITY, int_compare, int_hash, NULL, NULL);
+    srand(3);
+
+    for (i = 0; i < CHURN_OPS; i++) {
+        uintptr_t key = 1 + rand() % CHURN_KEYS;
+        int op = rand() % 3;
+
+        int at = -1;
+        for (j = 0; j < model_count; j++) {
+            if (model[j] == key) {
+                at = j;
+            }
+        }
+
+        if (op == 0) {
+            void *got = LRU_get(lru, (void *)key);
+            mu_assert((at >= 0) == (got == (void *)key), "Get differs.");
+        } else if (op == 1) {
+            LRU_put(lru, (void *)key, (void *)key);
+            if (at < 0 && model_count == CHURN_CAPACITY) {
+                at = model_count - 1;
+            } else if (at < 0) {
+                at = model_count++;
+            }
+        } else {
+            mu_assert(LRU_delete(lru, (void *)key) == (at >= 0 ? 0 : -1),
+                    "Delete differs.");
+            if (at >= 0) {
+                memmove(&model[at], &model[at + 1],
+                        (model_count - at - 1) * sizeof(uintptr_t));
+                model_count--;
+            }
+            continue;
+        }
+
+        // move the used (or replaced) key to the front
+        if (at >= 0) {
+            memmove(&model[1], &model[0], at * sizeof(uintptr_t));
+            model[0] = key;
+        }
+    }
+
+    mu_assert(LRU_count(lru) == model_count, "Wrong count after churn.");
+    j = 0;
+    LIST_FOREACH(lru->recency, first, next, cur) {
+        LRUEntry *entry = cur->value;
+        mu_assert((uintptr_t)entry->key == model[j], "Wrong recency order.");
+        j++;
+    }
+
+    LRU_destroy(lru);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_get_put);
+    mu_run_test(test_destroy);
+    mu_run_test(test_churn);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
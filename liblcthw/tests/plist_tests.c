@@ -0,0 +1,148 @@
+#include "minunit.h"
+#include <lcthw/plist.h>
+#include <pthread.h>
+#include <stdint.h>
+
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+char *test3 = "test3 data";
+
+char *test_versions()
+{
+    PList *one = PList_push(NULL, test1);
+    PList *two = PList_push(one, test2);
+    PList *three = PList_push(two, test3);
+
+    mu_assert(PList_count(one) == 1 && PList_count(three) == 3,
+            "Wrong counts.");
+    mu_assert(PList_last(two) == test2, "Wrong last value.");
+    mu_assert(PList_get(three, 0) == test1, "Wrong first value.");
+    mu_assert(PList_get(three, 3) == NULL, "Get out of bounds.");
+
+    // a branch off an old version leaves the newer one alone
+    PList *other = PList_push(one, test3);
+    mu_assert(PList_count(other) == 2 && PList_get(other, 1) == test3,
+            "Wrong branch.");
+    mu_assert(PList_get(two, 1) == test2, "Branch changed old version.");
+    mu_assert(other->prev == one && two->prev == one,
+            "Versions should share their nodes.");
+
+    PList *popped = PList_pop(three);
+    mu_assert(popped == two, "Pop should give back the older version.");
+    mu_assert(PList_count(three) == 3, "Pop changed the version.");
+
+    void *values[3];
+    mu_assert(PList_to_array(three, values) == 3, "Wrong to_array count.");
+    mu_assert(values[0] == test1 && values[1] == test2 && values[2] == test3,
+            "to_array isn't oldest first.");
+
+    // the nodes go when the last version using them does
+    PList_release(popped);
+    PList_release(one);
+    PList_release(two);
+    PList_release(other);
+    mu_assert(PList_get(three, 0) == test1, "Shared node freed too early.");
+    PList_release(three);
+
+    PList *empty = NULL;
+    mu_assert(PList_pop(empty) == NULL && PList_count(empty) == 0,
+            "Empty list handling.");
+
+    return NULL;
+}
+
+#define READERS 4
+#define APPENDS 100000
+
+// The writer publishes each new version here; readers snapshot it.
+static pthread_mutex_t current_lock = PTHREAD_MUTEX_INITIALIZER;
+static PList *current = NULL;
+static atomic_int writing;
+
+static void *reader(void *arg)
+{
+    intptr_t bad = 0;
+    (void)arg;
+
+    while (atomic_load(&writing)) {
+        pthread_mutex_lock(&current_lock);
+        PList *snapshot = PList_retain(current);
+        pthread_mutex_unlock(&current_lock);
+
+        // no lock needed to read a version we hold
+        int expected = PList_count(snapshot);
+        PLIST_FOREACH(snapshot, cur) {
+            if ((intptr_t)cur->value != expected--) {
+                bad++;
+            }
+            // don't walk all of a long version every time
+            if (expected < PList_count(snapshot) - 100) {
+                break;
+            }
+        }
+
+        PList_release(snapshot);
+    }
+
+    return (void *)bad;
+}
+
+char *test_snapshots()
+{
+    pthread_t readers[READERS];
+    intptr_t i = 0;
+
+    atomic_init(&writing, 1);
+    for (i = 0; i < READERS; i++) {
+        mu_assert(pthread_create(&readers[i], NULL, reader, NULL) == 0,
+                "Failed to start reader.");
+    }
+
+    for (i = 1; i <= APPENDS; i++) {
+        // every value is its position, so readers can check it
+        PList *next = PList_push(current,
+                (void *)(intptr_t)(PList_count(current) + 1));
+
+        pthread_mutex_lock(&current_lock);
+        PList *old = current;
+        current = next;
+        pthread_mutex_unlock(&current_lock);
+
+        PList_release(old);
+
+        // drop some values again so old versions get freed
+        if (i % 10 == 0) {
+            next = PList_pop(current);
+            pthread_mutex_lock(&current_lock);
+            old = current;
+            current = next;
+            pthread_mutex_unlock(&current_lock);
+            PList_release(old);
+        }
+    }
+    atomic_store(&writing, 0);
+
+    for (i = 0; i < READERS; i++) {
+        void *bad = NULL;
+        pthread_join(readers[i], &bad);
+        mu_assert(bad == NULL, "Reader saw a changed snapshot.");
+    }
+
+    mu_assert(PList_count(current) == APPENDS - APPENDS / 10,
+            "Wrong final count.");
+    PList_release(current);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_versions);
+    mu_run_test(test_snapshots);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,87 @@
+#include "minunit.h"
+#include <lcthw/thread_slot.h>
+#include <pthread.h>
+
+static int owner_a = 0;
+static int owner_b = 0;
+static atomic_int released;
+
+static void count_release(void *data)
+{
+    atomic_fetch_add(&released, *(int *)data);
+}
+
+char *test_get_set()
+{
+    int one = 1;
+    int two = 2;
+
+    mu_assert(ThreadSlot_get(&owner_a) == NULL, "Unset slot has data.");
+
+    mu_assert(ThreadSlot_set(&owner_a, &one, NULL) == 0, "Set failed.");
+    mu_assert(ThreadSlot_set(&owner_b, &two, NULL) == 0, "Set failed.");
+    mu_assert(ThreadSlot_get(&owner_a) == &one, "Wrong data for a.");
+    mu_assert(ThreadSlot_get(&owner_b) == &two, "Wrong data for b.");
+
+    mu_assert(ThreadSlot_set(&owner_a, &two, NULL) == 0, "Reset failed.");
+    mu_assert(ThreadSlot_get(&owner_a) == &two, "Reset didn't stick.");
+
+    ThreadSlot_drop(&owner_a);
+    mu_assert(ThreadSlot_get(&owner_a) == NULL, "Dropped owner has data.");
+    mu_assert(ThreadSlot_get(&owner_b) == &two, "Drop hit another owner.");
+    ThreadSlot_drop(&owner_b);
+
+    return NULL;
+}
+
+// Sets a slot for both owners with weights 1 and 10, then exits.
+static void *use_slots(void *arg)
+{
+    static int one = 1;
+    static int ten = 10;
+
+    ThreadSlot_set(&owner_a, &one, count_release);
+    ThreadSlot_set(&owner_b, &ten, count_release);
+    if (arg) {
+        ThreadSlot_drop(&owner_b);
+    }
+
+    return NULL;
+}
+
+char *test_thread_exit()
+{
+    pthread_t thread;
+
+    atomic_store(&released, 0);
+    mu_assert(pthread_create(&thread, NULL, use_slots, NULL) == 0,
+            "Failed to start thread.");
+    pthread_join(thread, NULL);
+    mu_assert(atomic_load(&released) == 11,
+            "Exit should release every slot.");
+
+    // a dropped owner is gone, so there is nothing of it to release
+    atomic_store(&released, 0);
+    mu_assert(pthread_create(&thread, NULL, use_slots, &owner_b) == 0,
+            "Failed to start thread.");
+    pthread_join(thread, NULL);
+    mu_assert(atomic_load(&released) == 1,
+            "Exit released a dropped owner.");
+
+    mu_assert(ThreadSlot_get(&owner_a) == NULL,
+            "Another thread's slot leaked into this one.");
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_get_set);
+    mu_run_test(test_thread_exit);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,52 @@
+#include "bench.h"
+#include <lcthw/list.h>
+#include <lcthw/ulist.h>
+
+static char *value = "bench";
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 10000000);
+    int n = 0;
+    int i = 0;
+    double secs = 0;
+    size_t sum = 0;
+
+    printf("----\nBENCH: List vs UList push, iterate, shift\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        List *list = List_create();
+        UList *ulist = UList_create();
+
+        BENCH(secs, for (i = 0; i < n; i++) List_push(list, value));
+        bench_report("List push", n, secs);
+        BENCH(secs, for (i = 0; i < n; i++) UList_push(ulist, value));
+        bench_report("UList push", n, secs);
+
+        BENCH(secs, {
+            LIST_FOREACH(list, first, next, cur) {
+                sum += (size_t)cur->value;
+            }
+        });
+        bench_report("List iterate", n, secs);
+        BENCH(secs, {
+            ULIST_FOREACH(ulist, node, slot, val) {
+                sum += (size_t)val;
+            }
+        });
+        bench_report("UList iterate", n, secs);
+
+        BENCH(secs, for (i = 0; i < n; i++) List_shift(list));
+        bench_report("List shift", n, secs);
+        BENCH(secs, for (i = 0; i < n; i++) UList_shift(ulist));
+        bench_report("UList shift", n, secs);
+
+        List_destroy(list);
+        UList_destroy(ulist);
+    }
+
+    // keeps the iteration loops from being optimized away
+    printf("checksum %zu\n", sum);
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "minunit.h"
+#include <lcthw/ulist.h>
+#include <assert.h>
+
+#define NUM_VALUES 1000
+
+static UList *list = NULL;
+static int values[NUM_VALUES];
+
+char *test_create()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES; i++) {
+        values[i] = i;
+    }
+
+    list = UList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    UList_destroy(list);
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES; i++) {
+        UList_push(list, &values[i]);
+        mu_assert(UList_last(list) == &values[i], "Wrong last value.");
+    }
+    mu_assert(UList_count(list) == NUM_VALUES, "Wrong count on push.");
+    mu_assert(UList_first(list) == &values[0], "Wrong first value.");
+
+    for (i = NUM_VALUES - 1; i >= 0; i--) {
+        int *val = UList_pop(list);
+        mu_assert(val == &values[i], "Wrong value on pop.");
+    }
+    mu_assert(UList_count(list) == 0, "Wrong count after pop.");
+    mu_assert(list->first == NULL && list->last == NULL,
+            "Empty list should have no nodes.");
+    mu_assert(UList_pop(list) == NULL, "Pop of empty list should be NULL.");
+
+    return NULL;
+}
+
+char *test_unshift_shift()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES; i++) {
+        UList_unshift(list, &values[i]);
+        mu_assert(UList_first(list) == &values[i], "Wrong first value.");
+    }
+    mu_assert(UList_count(list) == NUM_VALUES, "Wrong count on unshift.");
+
+    for (i = NUM_VALUES - 1; i >= 0; i--) {
+        int *val = UList_shift(list);
+        mu_assert(val == &values[i], "Wrong value on shift.");
+    }
+    mu_assert(UList_count(list) == 0, "Wrong count after shift.");
+    mu_assert(UList_shift(list) == NULL,
+            "Shift of empty list should be NULL.");
+
+    return NULL;
+}
+
+char *test_foreach()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES / 2; i++) {
+        UList_push(list, &values[NUM_VALUES / 2 + i]);
+        UList_unshift(list, &values[NUM_VALUES / 2 - 1 - i]);
+    }
+
+    int expect = 0;
+    ULIST_FOREACH(list, node, slot, val) {
+        mu_assert(val == &values[expect], "Wrong value in foreach.");
+        expect++;
+    }
+    mu_assert(expect == NUM_VALUES, "Foreach missed values.");
+
+    return NULL;
+}
+
+static int remove_first_odd(UList * list)
+{
+    ULIST_FOREACH(list, node, i, val) {
+        if (*(int *)val % 2) {
+            UList_remove(list, node, i);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+char *test_remove()
+{
+    // drop every odd value, mostly from the middle of the nodes
+    int removed = 0;
+    while (remove_first_odd(list)) {
+        removed++;
+    }
+
+    mu_assert(removed == NUM_VALUES / 2, "Wrong number removed.");
+    mu_assert(UList_count(list) == NUM_VALUES / 2, "Wrong count after remove.");
+
+    int expect = 0;
+    ULIST_FOREACH(list, n, slot, val) {
+        mu_assert(*(int *)val == expect, "Wrong value after remove.");
+        expect += 2;
+    }
+
+    return NULL;
+}
+
+char *test_split_join()
+{
+    int count = UList_count(list);
+
+    UList *tail = UList_split(list, 7);
+    mu_assert(tail != NULL, "Split failed.");
+    mu_assert(UList_count(list) == 7, "Wrong count after split.");
+    mu_assert(UList_count(tail) == count - 7, "Wrong tail count.");
+    mu_assert(*(int *)UList_last(list) == 12, "Wrong last after split.");
+    mu_assert(*(int *)UList_first(tail) == 14, "Wrong first of tail.");
+
+    UList_join(list, tail);
+    mu_assert(UList_count(list) == count, "Wrong count after join.");
+    mu_assert(UList_count(tail) == 0, "Joined list should be emptied.");
+    UList_destroy(tail);
+
+    int expect = 0;
+    ULIST_FOREACH(list, node, slot, val) {
+        mu_assert(*(int *)val == expect, "Wrong value after join.");
+        expect += 2;
+    }
+
+    UList *all = UList_split(list, 0);
+    mu_assert(UList_count(list) == 0, "Split at 0 should empty list.");
+    mu_assert(UList_count(all) == count, "Split at 0 should move all.");
+    UList_join(list, all);
+    UList_destroy(all);
+
+    UList *none = UList_split(list, count);
+    mu_assert(UList_count(none) == 0, "Split at end should be empty.");
+    UList_destroy(none);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_unshift_shift);
+    mu_run_test(test_foreach);
+    mu_run_test(test_remove);
+    mu_run_test(test_split_join);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
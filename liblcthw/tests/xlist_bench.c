@@ -0,0 +1,91 @@
+#include "bench.h"
+#include <lcthw/list.h>
+#include <lcthw/xlist.h>
+#include <malloc.h>
+
+static char *value = "bench";
+
+// Heap bytes in use, so List's per-node malloc overhead is counted.
+// Big slabs are mmapped, which uordblks leaves out.
+static size_t heap_used()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static void report_memory(const char *name, size_t before, int n)
+{
+    printf("%-28s n=%-9d %9.2f bytes/element\n", name, n,
+            (double)(heap_used() - before) / n);
+}
+
+int main(int argc, char *argv[])
+{
+    int max_n = bench_max_n(argc, argv, 10000000);
+    int n = 0;
+    int i = 0;
+    double secs = 0;
+    size_t sum = 0;
+    size_t before = 0;
+
+    printf("----\nBENCH: List vs pooled List vs XList\n");
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        before = heap_used();
+        List *list = List_create();
+        BENCH(secs, for (i = 0; i < n; i++) List_push(list, value));
+        bench_report("List push", n, secs);
+        report_memory("List memory", before, n);
+
+        before = heap_used();
+        List *pooled = List_create_pooled(NULL);
+        BENCH(secs, for (i = 0; i < n; i++) List_push(pooled, value));
+        bench_report("pooled List push", n, secs);
+        report_memory("pooled List memory", before, n);
+
+        before = heap_used();
+        XList *xlist = XList_create();
+        BENCH(secs, for (i = 0; i < n; i++) XList_push(xlist, value));
+        bench_report("XList push", n, secs);
+        report_memory("XList memory", before, n);
+
+        BENCH(secs, {
+            LIST_FOREACH(list, first, next, cur) {
+                sum += (size_t)cur->value;
+            }
+        });
+        bench_report("List iterate", n, secs);
+        BENCH(secs, {
+            LIST_FOREACH(pooled, first, next, cur) {
+                sum += (size_t)cur->value;
+            }
+        });
+        bench_report("pooled List iterate", n, secs);
+        BENCH(secs, {
+            XLIST_FOREACH(xlist, first, cur) {
+                sum += (size_t)cur->value;
+            }
+        });
+        bench_report("XList iterate", n, secs);
+        BENCH(secs, {
+            XLIST_FOREACH(xlist, last, cur) {
+                sum += (size_t)cur->value;
+            }
+        });
+        bench_report("XList iterate back", n, secs);
+
+        BENCH(secs, for (i = 0; i < n; i++) List_shift(pooled));
+        bench_report("pooled List shift", n, secs);
+        BENCH(secs, for (i = 0; i < n; i++) XList_shift(xlist));
+        bench_report("XList shift", n, secs);
+
+        List_destroy(list);
+        List_destroy(pooled);
+        XList_destroy(xlist);
+    }
+
+    // keeps the iteration loops from being optimized away
+    printf("checksum %zu\n", sum);
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "minunit.h"
+#include <lcthw/xlist.h>
+#include <lcthw/list.h>
+#include <stdint.h>
+
+#define NUM_VALUES 1000
+
+static XList *list = NULL;
+static int values[NUM_VALUES];
+
+char *test_create()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES; i++) {
+        values[i] = i;
+    }
+
+    mu_assert(sizeof(XListNode) <= 16, "XListNode should be two words.");
+
+    list = XList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+    mu_assert(XList_pop(list) == NULL, "Pop of empty list.");
+    mu_assert(XList_shift(list) == NULL, "Shift of empty list.");
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES; i++) {
+        XList_push(list, &values[i]);
+        mu_assert(XList_last(list) == &values[i], "Wrong last value.");
+    }
+    mu_assert(XList_count(list) == NUM_VALUES, "Wrong count on push.");
+    mu_assert(XList_first(list) == &values[0], "Wrong first value.");
+
+    for (i = NUM_VALUES - 1; i >= 0; i--) {
+        mu_assert(XList_pop(list) == &values[i], "Wrong value on pop.");
+    }
+    mu_assert(XList_count(list) == 0, "Wrong count after pop.");
+    mu_assert(list->first == NULL && list->last == NULL,
+            "Empty list should have no nodes.");
+
+    return NULL;
+}
+
+char *test_unshift_shift()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES; i++) {
+        XList_unshift(list, &values[i]);
+        mu_assert(XList_first(list) == &values[i], "Wrong first value.");
+    }
+    mu_assert(XList_count(list) == NUM_VALUES, "Wrong count on unshift.");
+
+    for (i = NUM_VALUES - 1; i >= 0; i--) {
+        mu_assert(XList_shift(list) == &values[i], "Wrong value on shift.");
+    }
+    mu_assert(XList_count(list) == 0, "Wrong count after shift.");
+
+    return NULL;
+}
+
+char *test_foreach()
+{
+    int i = 0;
+    for (i = 0; i < NUM_VALUES / 2; i++) {
+        XList_push(list, &values[NUM_VALUES / 2 + i]);
+        XList_unshift(list, &values[NUM_VALUES / 2 - 1 - i]);
+    }
+
+    int expect = 0;
+    XLIST_FOREACH(list, first, cur) {
+        mu_assert(cur->value == &values[expect], "Wrong forward order.");
+        expect++;
+    }
+    mu_assert(expect == NUM_VALUES, "Forward walk missed values.");
+
+    {
+        XLIST_FOREACH(list, last, cur) {
+            expect--;
+            mu_assert(cur->value == &values[expect], "Wrong backward order.");
+        }
+    }
+    mu_assert(expect == 0, "Backward walk missed values.");
+
+    // emptying and refilling reuses the nodes already allocated
+    size_t memory = XList_memory(list);
+    for (i = 0; i < NUM_VALUES; i++) {
+        XList_shift(list);
+    }
+    for (i = 0; i < NUM_VALUES; i++) {
+        XList_push(list, &values[i]);
+    }
+    mu_assert(XList_memory(list) == memory, "Freed nodes weren't reused.");
+
+    for (i = 0; i < NUM_VALUES; i++) {
+        XList_pop(list);
+    }
+
+    return NULL;
+}
+
+// Runs the same random operations on an XList and a List.
+char *test_against_list()
+{
+    List *expected = List_create();
+    intptr_t i = 0;
+
+    srand(7);
+    for (i = 1; i < 100000; i++) {
+        int op = rand() % 4;
+        // drift up and down so the list grows and empties
+        if ((i / 20000) % 2 && op < 2) {
+            op += 2;
+        }
+
+        if (op == 0) {
+            XList_push(list, (void *)i);
+            List_push(expected, (void *)i);
+        } else if (op == 1) {
+            XList_unshift(list, (void *)i);
+            List_unshift(expected, (void *)i);
+        } else if (op == 2) {
+            mu_assert(XList_pop(list) == List_pop(expected), "Pop differs.");
+        } else {
+            mu_assert(XList_shift(list) == List_shift(expected),
+                    "Shift differs.");
+        }
+        mu_assert(XList_count(list) == List_count(expected),
+                "Count differs.");
+    }
+
+    ListNode *node = expected->last;
+    XLIST_FOREACH(list, last, cur) {
+        mu_assert(node != NULL && cur->value == node->value,
+                "Contents differ.");
+        node = node->prev;
+    }
+    mu_assert(node == NULL, "XList is shorter than List.");
+
+    List_destroy(expected);
+    while (XList_pop(list)) {
+    }
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    XList_push(list, malloc(8));
+    XList_unshift(list, malloc(8));
+    XList_clear_destroy(list);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_unshift_shift);
+    mu_run_test(test_foreach);
+    mu_run_test(test_against_list);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);